@@ -0,0 +1,47 @@
+#pragma once
+#include <queue>
+#include <stack>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace bench {
+
+  template <typename Adaptor>
+  void adaptor_suite(Runner& runner, const std::string& type) {
+    for (std::size_t n : sizes()) {
+      if (wanted(runner, type, false, n)) {
+        Adaptor flat;
+        for (std::size_t i = 0; i < n; i++)
+          flat.push(static_cast<typename Adaptor::value_type>(i));
+        print_cases(runner, type, false, n, flat);
+      }
+    }
+  }
+
+  inline void adaptor_suites(Runner& runner) {
+    adaptor_suite<std::queue<int>>(runner, "queue<int>");
+    adaptor_suite<std::priority_queue<int>>(runner, "priority_queue<int>");
+    adaptor_suite<std::stack<int>>(runner, "stack<int>");
+    for (std::size_t n : sizes()) {
+      if (runner.enabled("priority_queue<int>/flat/heap_order", n)) {
+        std::priority_queue<int> flat;
+        for (std::size_t i = 0; i < n; i++)
+          flat.push(static_cast<int>(i));
+        runner.run("priority_queue<int>/flat/heap_order", n, [&](std::ostream& stream) {
+          pprint::PrettyPrinter printer(stream);
+          printer.heap_order(true);
+          printer.print(flat);
+        });
+      }
+    }
+    for (std::size_t n : sizes()) {
+      if (wanted(runner, "queue<vector<int>>", true, n)) {
+        std::queue<std::vector<int>> nested;
+        for (std::size_t i = 0; i < n; i += 10)
+          nested.push(std::vector<int>(10, static_cast<int>(i)));
+        print_cases(runner, "queue<vector<int>>", true, n, nested);
+      }
+    }
+  }
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace bench {
+
+  inline std::vector<int> row_of_ten(std::size_t first) {
+    std::vector<int> row;
+    for (std::size_t j = first; j < first + 10; j++)
+      row.push_back(static_cast<int>(j));
+    return row;
+  }
+
+  inline void set_suite(Runner& runner) {
+    for (std::size_t n : sizes()) {
+      if (wanted(runner, "set<int>", false, n)) {
+        std::set<int> flat;
+        for (std::size_t i = 0; i < n; i++)
+          flat.insert(flat.end(), static_cast<int>(i));
+        print_cases(runner, "set<int>", false, n, flat);
+      }
+      if (wanted(runner, "set<int>", true, n)) {
+        std::set<std::set<int>> nested;
+        for (std::size_t i = 0; i < n; i += 10) {
+          auto row = row_of_ten(i);
+          nested.insert(nested.end(), std::set<int>(row.begin(), row.end()));
+        }
+        print_cases(runner, "set<int>", true, n, nested);
+      }
+    }
+  }
+
+  // map and unordered_map: N int -> int pairs, and N/10 keys mapping to
+  // vectors of 10 ints
+  template <template<typename...> class Map>
+  void map_suite(Runner& runner, const std::string& type) {
+    for (std::size_t n : sizes()) {
+      if (wanted(runner, type + "<int, int>", false, n)) {
+        Map<int, int> flat;
+        for (std::size_t i = 0; i < n; i++)
+          flat.emplace(static_cast<int>(i), static_cast<int>(i));
+        print_cases(runner, type + "<int, int>", false, n, flat);
+      }
+      if (wanted(runner, type + "<int, int>", true, n)) {
+        Map<int, std::vector<int>> nested;
+        for (std::size_t i = 0; i < n; i += 10)
+          nested.emplace(static_cast<int>(i), row_of_ten(i));
+        print_cases(runner, type + "<int, int>", true, n, nested);
+      }
+    }
+  }
+
+  inline void associative_suites(Runner& runner) {
+    set_suite(runner);
+    map_suite<std::map>(runner, "map");
+    map_suite<std::unordered_map>(runner, "unordered_map");
+  }
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdio>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace bench {
+
+  // Hand-written dumps producing the same text as a compact pprint of the
+  // vector, as a floor for what pprint could cost
+
+  template <typename T>
+  void ostream_dump(std::ostream& stream, const std::vector<T>& value) {
+    stream << '[';
+    for (std::size_t i = 0; i < value.size(); i++) {
+      if (i)
+        stream << ", ";
+      stream << value[i];
+    }
+    stream << "]\n";
+  }
+
+  inline int format_value(char * out, std::size_t size, int value) {
+    return std::snprintf(out, size, "%d", value);
+  }
+
+  inline int format_value(char * out, std::size_t size, double value) {
+    return std::snprintf(out, size, "%g", value);
+  }
+
+  template <typename T>
+  void snprintf_dump(std::ostream& stream, const std::vector<T>& value) {
+    char block[1 << 16];
+    std::size_t used = 0;
+    block[used++] = '[';
+    for (std::size_t i = 0; i < value.size(); i++) {
+      if (used + 64 > sizeof(block)) {
+        stream.write(block, static_cast<std::streamsize>(used));
+        used = 0;
+      }
+      if (i) {
+        block[used++] = ',';
+        block[used++] = ' ';
+      }
+      used += static_cast<std::size_t>(format_value(block + used, 64, value[i]));
+    }
+    block[used++] = ']';
+    block[used++] = '\n';
+    stream.write(block, static_cast<std::streamsize>(used));
+  }
+
+  template <typename T>
+  void baseline_suite(Runner& runner, const std::string& type) {
+    for (std::size_t n : sizes()) {
+      if (!runner.enabled("baseline/ostream/" + type, n) &&
+          !runner.enabled("baseline/snprintf/" + type, n))
+        continue;
+      std::vector<T> value;
+      value.reserve(n);
+      for (std::size_t i = 0; i < n; i++)
+        value.push_back(static_cast<T>(i) * static_cast<T>(1.0001));
+      runner.run("baseline/ostream/" + type, n, [&](std::ostream& stream) {
+        ostream_dump(stream, value);
+      });
+      runner.run("baseline/snprintf/" + type, n, [&](std::ostream& stream) {
+        snprintf_dump(stream, value);
+      });
+    }
+  }
+
+  inline void baseline_suites(Runner& runner) {
+    baseline_suite<int>(runner, "vector<int>");
+    baseline_suite<double>(runner, "vector<double>");
+  }
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace bench {
+
+  // The same values printed as text and captured with OutputFormat::binary,
+  // for what capturing saves a hot path. JSON is timed alongside, as the
+  // other format with no layout.
+  template <typename T>
+  void format_cases(Runner& runner, const std::string& type, std::size_t elements, const T& value) {
+    const std::pair<const char *, pprint::OutputFormat> formats[] = {
+      {"text", pprint::OutputFormat::text},
+      {"json", pprint::OutputFormat::json},
+      {"binary", pprint::OutputFormat::binary}};
+    for (const auto& format : formats) {
+      runner.run("format/" + std::string(format.first) + "/" + type, elements, [&](std::ostream& stream) {
+        pprint::PrettyPrinter printer(stream);
+        printer.output_format(format.second);
+        printer.print(value);
+      });
+    }
+  }
+
+  inline bool format_wanted(const Runner& runner, const std::string& type, std::size_t elements) {
+    for (const char * format : {"text", "json", "binary"}) {
+      if (runner.enabled("format/" + std::string(format) + "/" + type, elements))
+        return true;
+    }
+    return false;
+  }
+
+  inline void format_suite(Runner& runner) {
+    for (std::size_t n : sizes()) {
+      if (format_wanted(runner, "map<string, vector<double>>", n)) {
+        std::map<std::string, std::vector<double>> map;
+        for (std::size_t i = 0; i < n; i += 3) {
+          const double x = static_cast<double>(i);
+          map["key " + std::to_string(i)] = {x * 0.5, x * -1.25, 3.0};
+        }
+        format_cases(runner, "map<string, vector<double>>", n, map);
+      }
+      if (format_wanted(runner, "vector<long long>", n)) {
+        std::vector<long long> numbers(n);
+        for (std::size_t i = 0; i < n; i++)
+          numbers[i] = static_cast<long long>(i * 7919);
+        format_cases(runner, "vector<long long>", n, numbers);
+      }
+    }
+  }
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <map>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace bench {
+
+  // Expanded printing with an indent wider than any small-string buffer, so
+  // any per-line allocation of the indentation shows up in allocs/print
+  inline void indent_suite(Runner& runner) {
+    const size_t indent = 32;
+    for (std::size_t n : sizes()) {
+      if (runner.enabled("indent/deep/vector<vector<int>>", n)) {
+        std::vector<std::vector<int>> nested;
+        for (std::size_t i = 0; i < n; i += 10)
+          nested.emplace_back(10, static_cast<int>(i));
+        runner.run("indent/deep/vector<vector<int>>", n, [&](std::ostream& stream) {
+          pprint::PrettyPrinter printer(stream);
+          printer.indent(indent);
+          printer.print(nested);
+        });
+      }
+      if (runner.enabled("indent/deep/map<int, vector<int>>", n)) {
+        std::map<int, std::vector<int>> nested;
+        for (std::size_t i = 0; i < n; i += 10)
+          nested.emplace(static_cast<int>(i), std::vector<int>(10, static_cast<int>(i)));
+        runner.run("indent/deep/map<int, vector<int>>", n, [&](std::ostream& stream) {
+          pprint::PrettyPrinter printer(stream);
+          printer.indent(indent);
+          printer.print_inline(nested);
+        });
+      }
+    }
+  }
+
+}
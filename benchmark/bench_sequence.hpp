@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <deque>
+#include <list>
+#include <memory>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace bench {
+
+  // vector, list and deque: flat N ints, and N ints split into rows of 10
+  template <template<typename...> class Sequence>
+  void sequence_suite(Runner& runner, const std::string& type) {
+    for (std::size_t n : sizes()) {
+      if (wanted(runner, type + "<int>", false, n)) {
+        Sequence<int> flat;
+        for (std::size_t i = 0; i < n; i++)
+          flat.push_back(static_cast<int>(i));
+        print_cases(runner, type + "<int>", false, n, flat);
+      }
+      if (wanted(runner, type + "<int>", true, n)) {
+        Sequence<Sequence<int>> nested;
+        for (std::size_t i = 0; i < n; i += 10) {
+          Sequence<int> row;
+          for (std::size_t j = i; j < i + 10 && j < n; j++)
+            row.push_back(static_cast<int>(j));
+          nested.push_back(row);
+        }
+        print_cases(runner, type + "<int>", true, n, nested);
+      }
+    }
+  }
+
+  inline void double_suite(Runner& runner) {
+    for (std::size_t n : sizes()) {
+      if (!wanted(runner, "vector<double>", false, n))
+        continue;
+      std::vector<double> flat;
+      flat.reserve(n);
+      for (std::size_t i = 0; i < n; i++)
+        flat.push_back(static_cast<double>(i) * 1.0001);
+      print_cases(runner, "vector<double>", false, n, flat);
+    }
+  }
+
+  // std::array sizes are compile-time constants, so each size is its own
+  // instantiation. The arrays live on the heap, the printer is handed a
+  // reference.
+  template <std::size_t N>
+  void array_suite(Runner& runner) {
+    if (wanted(runner, "array<int>", false, N)) {
+      auto flat = std::make_unique<std::array<int, N>>();
+      for (std::size_t i = 0; i < N; i++)
+        (*flat)[i] = static_cast<int>(i);
+      print_cases(runner, "array<int>", false, N, *flat);
+    }
+    if (wanted(runner, "array<int>", true, N)) {
+      auto nested = std::make_unique<std::array<std::array<int, 10>, N / 10>>();
+      for (std::size_t i = 0; i < N / 10; i++)
+        for (std::size_t j = 0; j < 10; j++)
+          (*nested)[i][j] = static_cast<int>(i * 10 + j);
+      print_cases(runner, "array<int>", true, N, *nested);
+    }
+  }
+
+  inline void sequence_suites(Runner& runner) {
+    sequence_suite<std::vector>(runner, "vector");
+    double_suite(runner);
+    array_suite<10>(runner);
+    array_suite<10000>(runner);
+    array_suite<10000000>(runner);
+    sequence_suite<std::list>(runner, "list");
+    sequence_suite<std::deque>(runner, "deque");
+  }
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace bench {
+
+  // variant, optional and tuple are printed as the elements of a vector of N
+  inline void utility_suites(Runner& runner) {
+    using Variant = std::variant<int, double, std::string>;
+    using Tuple = std::tuple<int, double, std::string>;
+
+    for (std::size_t n : sizes()) {
+      if (wanted(runner, "vector<variant>", false, n)) {
+        std::vector<Variant> flat;
+        flat.reserve(n);
+        for (std::size_t i = 0; i < n; i++) {
+          switch (i % 3) {
+          case 0: flat.emplace_back(static_cast<int>(i)); break;
+          case 1: flat.emplace_back(static_cast<double>(i) * 0.5); break;
+          default: flat.emplace_back(std::string("item")); break;
+          }
+        }
+        print_cases(runner, "vector<variant>", false, n, flat);
+      }
+      if (wanted(runner, "vector<variant>", true, n)) {
+        std::vector<std::variant<int, std::vector<int>>> nested;
+        for (std::size_t i = 0; i < n; i += 10)
+          nested.emplace_back(std::vector<int>(10, static_cast<int>(i)));
+        print_cases(runner, "vector<variant>", true, n, nested);
+      }
+      if (wanted(runner, "vector<optional<int>>", false, n)) {
+        std::vector<std::optional<int>> flat;
+        flat.reserve(n);
+        for (std::size_t i = 0; i < n; i++) {
+          if (i % 4)
+            flat.emplace_back(static_cast<int>(i));
+          else
+            flat.emplace_back(std::nullopt);
+        }
+        print_cases(runner, "vector<optional<int>>", false, n, flat);
+      }
+      if (wanted(runner, "vector<int*>", false, n)) {
+        static int target = 0;
+        std::vector<int*> flat(n, &target);
+        print_cases(runner, "vector<int*>", false, n, flat);
+      }
+      if (wanted(runner, "vector<tuple>", false, n)) {
+        std::vector<Tuple> flat;
+        flat.reserve(n);
+        for (std::size_t i = 0; i < n; i++)
+          flat.emplace_back(static_cast<int>(i), static_cast<double>(i) * 0.5, "item");
+        print_cases(runner, "vector<tuple>", false, n, flat);
+      }
+    }
+  }
+
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <pprint.hpp>
+
+namespace bench {
+
+  // Incremented by the replacement operator new in main.cpp
+  extern std::atomic<std::size_t> allocation_count;
+
+  // Sizes every suite is run at (capped by Options::max_elements)
+  inline const std::vector<std::size_t>& sizes() {
+    static const std::vector<std::size_t> values {10, 10000, 10000000};
+    return values;
+  }
+
+  struct Options {
+    std::size_t max_elements = 10000000;
+    double min_time = 0.25; // seconds spent timing each case
+    std::string filter;
+  };
+
+  // Discards everything written to it, counting bytes so throughput can be
+  // reported without measuring the cost of a real terminal or file
+  class NullBuffer : public std::streambuf {
+  public:
+    std::size_t bytes() const { return bytes_; }
+    void reset() { bytes_ = 0; }
+
+  protected:
+    int_type overflow(int_type c) override {
+      if (!traits_type::eq_int_type(c, traits_type::eof()))
+        bytes_ += 1;
+      return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char_type *, std::streamsize n) override {
+      bytes_ += static_cast<std::size_t>(n);
+      return n;
+    }
+
+  private:
+    std::size_t bytes_ = 0;
+  };
+
+  class Runner {
+  public:
+    explicit Runner(const Options& options) : options_(options) {}
+
+    const Options& options() const { return options_; }
+
+    bool enabled(const std::string& name, std::size_t elements) const {
+      return elements <= options_.max_elements &&
+        (options_.filter.empty() || name.find(options_.filter) != std::string::npos);
+    }
+
+    void header() const {
+      std::printf("%-44s %10s %8s %14s %12s %12s %14s\n", "benchmark", "elements",
+                  "iters", "ns/print", "ns/element", "MB/s", "allocs/print");
+    }
+
+    // Times fn(std::ostream&) until options().min_time has elapsed. fn is
+    // expected to render one complete record into the stream.
+    template <typename F>
+    void run(const std::string& name, std::size_t elements, F&& fn) {
+      if (!enabled(name, elements))
+        return;
+
+      NullBuffer buffer;
+      std::ostream stream(&buffer);
+
+      // Warm-up, also measures the size of a single record
+      fn(stream);
+      const std::size_t bytes_per_print = buffer.bytes();
+
+      using clock = std::chrono::steady_clock;
+      const auto budget = std::chrono::duration<double>(options_.min_time);
+      std::size_t iterations = 0;
+      const std::size_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+      const auto start = clock::now();
+      auto elapsed = clock::duration::zero();
+      do {
+        fn(stream);
+        iterations += 1;
+        elapsed = clock::now() - start;
+      } while (elapsed < budget);
+      const std::size_t allocations =
+        allocation_count.load(std::memory_order_relaxed) - allocations_before;
+
+      const double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+      const double ns_per_print = ns / static_cast<double>(iterations);
+      const double ns_per_element = elements ? ns_per_print / static_cast<double>(elements) : 0.0;
+      const double mb_per_sec = ns_per_print > 0 ?
+        (static_cast<double>(bytes_per_print) / (1024.0 * 1024.0)) / (ns_per_print * 1e-9) : 0.0;
+
+      std::printf("%-44s %10zu %8zu %14.0f %12.2f %12.1f %14.1f\n", name.c_str(), elements,
+                  iterations, ns_per_print, ns_per_element, mb_per_sec,
+                  static_cast<double>(allocations) / static_cast<double>(iterations));
+      std::fflush(stdout);
+    }
+
+  private:
+    Options options_;
+  };
+
+  // "vector<int>/nested/compact" etc.
+  inline std::string case_name(const std::string& type, bool nested, bool compact) {
+    return type + (nested ? "/nested" : "/flat") + (compact ? "/compact" : "/expanded");
+  }
+
+  // Lets suites skip building large inputs nobody asked for
+  inline bool wanted(const Runner& runner, const std::string& type, bool nested, std::size_t elements) {
+    return runner.enabled(case_name(type, nested, true), elements) ||
+      runner.enabled(case_name(type, nested, false), elements);
+  }
+
+  // Runs a PrettyPrinter over value in both compact and expanded mode
+  template <typename T>
+  void print_cases(Runner& runner, const std::string& type, bool nested, std::size_t elements,
+                   const T& value) {
+    for (bool compact : {true, false}) {
+      runner.run(case_name(type, nested, compact), elements, [&](std::ostream& stream) {
+        pprint::PrettyPrinter printer(stream);
+        printer.compact(compact);
+        printer.print(value);
+      });
+    }
+  }
+
+}
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Compile-time benchmark for pprint.
+
+Generates translation units that print many distinct types, compiles each
+with -fsyntax-only and reports the best front-end wall time over a few runs.
+With clang, template instantiation counts are read from -ftime-trace; with
+gcc, the time spent in overload resolution and template instantiation is
+read from -ftime-report.
+
+    compile_bench.py --compiler g++ --include include [--count 32] [--repeat 3]
+"""
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def enum_declarations(count, traits):
+    lines = []
+    for i in range(count):
+        lines.append("enum class E%d { %s };" % (i, ", ".join("V%d" % v for v in range(8))))
+        if traits == "range":
+            lines.append("template <> struct pprint::enum_traits<E%d> {"
+                         " static constexpr int min = 0; static constexpr int max = 7; };" % i)
+        elif traits == "flags":
+            lines.append("template <> struct pprint::enum_traits<E%d> {"
+                         " static constexpr bool flags = true; };" % i)
+    body = ["  printer.print(E%d::V3);" % i for i in range(count)]
+    return lines, body
+
+
+def class_declarations(count):
+    # Alternate classes with and without operator<<, each printed alone and
+    # inside containers and adaptors, so that every overload is resolved
+    # for a new set of types
+    lines = []
+    body = []
+    for i in range(count):
+        lines.append("struct C%d { int value; bool operator<(const C%d& other) const"
+                     " { return value < other.value; } };" % (i, i))
+        if i % 2 == 0:
+            lines.append("std::ostream& operator<<(std::ostream& os, const C%d& c)"
+                         " { return os << c.value; }" % i)
+        body.append("  printer.print(C%d{}, std::vector<C%d>{}, std::map<int, std::list<C%d>>{},"
+                    " std::set<C%d>{}, std::stack<C%d>{}, std::unique_ptr<C%d>{});" % ((i,) * 6))
+    return lines, body
+
+
+def vector_declarations(count, header):
+    # Include cost: the same prints of std::vector<int> through the
+    # all-in-one header and through pprint/core.hpp alone
+    body = ["  printer.print(std::vector<int>(%d));" % i for i in range(count)]
+    return [], body, header
+
+
+# name -> function(count) returning (declarations, statements in main[, header])
+SCENARIOS = {
+    "enums/default-range": lambda count: enum_declarations(count, None),
+    "enums/registered-range": lambda count: enum_declarations(count, "range"),
+    "enums/flags": lambda count: enum_declarations(count, "flags"),
+    "types/classes": class_declarations,
+    "headers/pprint.hpp": lambda count: vector_declarations(count, "pprint.hpp"),
+    "headers/pprint/core.hpp": lambda count: vector_declarations(count, "pprint/core.hpp"),
+}
+
+
+def translation_unit(declarations, body, header="pprint.hpp"):
+    return "\n".join(["#include <%s>" % header] + declarations +
+                     ["int main() {", "  pprint::PrettyPrinter printer;"] + body +
+                     ["}", ""])
+
+
+def instantiation_count(trace_dir):
+    count = 0
+    for name in os.listdir(trace_dir):
+        if not name.endswith(".json"):
+            continue
+        with open(os.path.join(trace_dir, name)) as f:
+            events = json.load(f).get("traceEvents", [])
+        count += sum(1 for e in events if e.get("name", "").startswith("Instantiate"))
+    return count
+
+
+def report_seconds(report, phase):
+    # gcc -ftime-report lines: " phase name   : usr ( %) sys ( %) wall ( %) mem"
+    for line in report.splitlines():
+        name, _, times = line.partition(":")
+        if name.strip(" |") == phase:
+            return float(re.findall(r"([\d.]+)\s*\(", times)[2])
+    return None
+
+
+def compile_once(compiler, flags, source, trace_dir):
+    start = time.perf_counter()
+    result = subprocess.run([compiler] + flags + [source], check=True, cwd=trace_dir,
+                            stderr=subprocess.PIPE, universal_newlines=True)
+    return time.perf_counter() - start, result.stderr
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--include", required=True, help="directory containing pprint.hpp")
+    parser.add_argument("--count", type=int, default=32, help="distinct types per translation unit")
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--filter", default="")
+    args = parser.parse_args()
+    args.include = os.path.abspath(args.include)
+
+    version = subprocess.run([args.compiler, "--version"], check=True, stdout=subprocess.PIPE,
+                             universal_newlines=True).stdout
+    clang = "clang" in version
+    gcc = not clang and ("GCC" in version or "Free Software Foundation" in version)
+    print("%-28s %8s %12s %16s %12s %14s" % ("scenario", "types", "seconds", "instantiations",
+                                             "overload s", "instantiate s"))
+    for name, generate in SCENARIOS.items():
+        if args.filter not in name:
+            continue
+        work = tempfile.mkdtemp(prefix="pprint_compile_bench_")
+        try:
+            source = os.path.join(work, "tu.cpp")
+            with open(source, "w") as f:
+                f.write(translation_unit(*generate(args.count)))
+            flags = ["-std=c++17", "-fsyntax-only", "-I", args.include]
+            if clang:
+                flags.append("-ftime-trace")
+            best = min(compile_once(args.compiler, flags, source, work)[0] for _ in range(args.repeat))
+            instantiations = str(instantiation_count(work)) if clang else "-"
+            overload = instantiate = None
+            if gcc:
+                # -ftime-report slows gcc down, so it gets a run of its own
+                report = compile_once(args.compiler, flags + ["-ftime-report"], source, work)[1]
+                overload = report_seconds(report, "overload resolution")
+                instantiate = report_seconds(report, "template instantiation")
+            print("%-28s %8d %12.3f %16s %12s %14s" % (
+                name, args.count, best, instantiations,
+                "-" if overload is None else "%.3f" % overload,
+                "-" if instantiate is None else "%.3f" % instantiate))
+            sys.stdout.flush()
+        finally:
+            shutil.rmtree(work)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "benchmark.hpp"
+#include "bench_baseline.hpp"
+#include "bench_sequence.hpp"
+#include "bench_associative.hpp"
+#include "bench_adaptor.hpp"
+#include "bench_utility.hpp"
+#include "bench_indent.hpp"
+#include "bench_format.hpp"
+
+std::atomic<std::size_t> bench::allocation_count {0};
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+// operator new below is malloc-backed, so free() is the matching release
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Count every heap allocation made while printing
+void * operator new(std::size_t size) {
+  bench::allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void * ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+static void usage(const char * program) {
+  std::printf("usage: %s [--max-elements N] [--min-time SECONDS] [--filter SUBSTRING]\n", program);
+}
+
+int main(int argc, char * argv[]) {
+  bench::Options options;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--max-elements") == 0 && i + 1 < argc)
+      options.max_elements = std::strtoull(argv[++i], nullptr, 10);
+    else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+      options.min_time = std::strtod(argv[++i], nullptr);
+    else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+      options.filter = argv[++i];
+    else {
+      usage(argv[0]);
+      return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+
+  bench::Runner runner(options);
+  runner.header();
+  bench::baseline_suites(runner);
+  bench::sequence_suites(runner);
+  bench::associative_suites(runner);
+  bench::adaptor_suites(runner);
+  bench::utility_suites(runner);
+  bench::indent_suite(runner);
+  bench::format_suite(runner);
+  return 0;
+}
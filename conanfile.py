@@ -6,11 +6,11 @@ import os
 class PprintConan(ConanFile):
     name = "pprint"
     description = "Pretty Printer for Modern C++"
-    topics = ("pprint", "pretty", "printer", "single-header", "c++17")
+    topics = ("pprint", "pretty", "printer", "header-only", "c++17")
     homepage = "https://github.com/p-ranav/pprint"
     url = "https://github.com/p-ranav/pprint"
     license = "MIT"
-    exports_sources = "include/**", "test/**", "CMakeLists.txt", "LICENSE", "pprint.pc.in"
+    exports_sources = "include/**", "src/**", "cmake/**", "module/**", "test/**", "CMakeLists.txt", "LICENSE", "pprint.pc.in"
     exports = "LICENSE"
     no_copy_source = True
     requires = "catch2/2.11.0"
@@ -0,0 +1,86 @@
+// pprint/adapters.hpp: std::queue, std::priority_queue and std::stack
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "core.hpp"
+#include <queue>
+#include <stack>
+
+namespace pprint {
+
+  // Container adaptors keep their container (and comparator) as protected
+  // members; deriving from the adaptor gives read access without copying it
+  template <typename Adaptor>
+  struct adaptor_access : Adaptor {
+    static const typename Adaptor::container_type& container(const Adaptor& adaptor) {
+      return adaptor.*(&adaptor_access::c);
+    }
+
+    static const auto& compare(const Adaptor& adaptor) {
+      return adaptor.*(&adaptor_access::comp);
+    }
+  };
+
+  // Queues are printed front to back, on one line
+  template <>
+  struct category_printer<category::queue> {
+    template <typename Container>
+    static void print(PrettyPrinter& printer, const Container& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      typedef typename Container::value_type T;
+      const auto& container = adaptor_access<Container>::container(value);
+      printer.write_tag(CaptureTag::queue);
+      printer.print_elements(container.begin(), container.end(), container.size(), "[", "]",
+        is_container<T>::value, printer.element_printer(level), indent, level, true);
+    }
+  };
+
+  // Priority queues are printed in pop order, or in the order of the
+  // underlying heap when heap_order(true) is set. Pop order sorts pointers
+  // to the elements, the elements themselves are never copied; with
+  // max_items only the elements that will be printed are sorted.
+  template <>
+  struct category_printer<category::priority_queue> {
+    template <typename Container>
+    static void print(PrettyPrinter& printer, const Container& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      typedef typename Container::value_type T;
+      const auto& container = adaptor_access<Container>::container(value);
+      printer.write_tag(CaptureTag::queue);
+      if (printer.heap_order_) {
+        printer.print_elements(container.begin(), container.end(), container.size(), "[", "]",
+          is_container<T>::value, printer.element_printer(level), indent, level, true);
+      }
+      else {
+        const auto& compare = adaptor_access<Container>::compare(value);
+        std::vector<const T*> order;
+        order.reserve(container.size());
+        for (const auto& element : container)
+          order.push_back(&element);
+        const auto shown = order.begin() + static_cast<std::ptrdiff_t>(std::min(order.size(), printer.item_limit()));
+        std::partial_sort(order.begin(), shown, order.end(),
+          [&](const T* lhs, const T* rhs) { return compare(*rhs, *lhs); });
+        printer.print_elements(order.begin(), order.end(), order.size(), "[", "]", is_container<T>::value,
+          printer.element_printer(level, [](const T* element) -> const T& { return *element; }), indent, level,
+          true);
+      }
+    }
+  };
+
+  // Stacks are printed top to bottom, vertically
+  template <>
+  struct category_printer<category::stack> {
+    template <typename Container>
+    static void print(PrettyPrinter& printer, const Container& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      typedef typename Container::value_type T;
+      const auto& container = adaptor_access<Container>::container(value);
+      printer.write_tag(CaptureTag::stack);
+      printer.print_elements(container.rbegin(), container.rend(), container.size(), "[", "]",
+        is_container<T>::value, printer.element_printer(level), indent, level, false);
+    }
+  };
+
+}
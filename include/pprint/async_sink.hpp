@@ -0,0 +1,357 @@
+// pprint/async_sink.hpp: writing printed records from a background thread
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace pprint {
+
+  class PrettyPrinter;
+
+  // What AsyncSink::push does when the queue is full
+  // block costs next to no CPU while waiting: a push that finds the queue
+  // full yields a few times, then sleeps until the background thread frees
+  // a slot, so it waits for as long as the stream takes to write a record
+  enum class OverflowPolicy {
+    block,       // wait for the background thread to make room
+    drop_newest, // discard the record being pushed
+    drop_oldest  // discard the oldest queued record to make room
+  };
+
+  // Hands formatted records to a background thread that writes them to a
+  // stream or file descriptor, so that printing threads never wait on I/O.
+  // Records are queued in a bounded lock-free ring buffer (Vyukov's MPMC
+  // queue, with the background thread as the only regular consumer).
+  // Strings are swapped in and out of the slots, so their capacity is
+  // recycled and steady-state pushes do not allocate.
+  class AsyncSink {
+  public:
+    explicit AsyncSink(std::ostream& stream, size_t capacity = 1024,
+        OverflowPolicy overflow = OverflowPolicy::block) :
+      AsyncSink(&stream, -1, capacity, overflow) {}
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Writes to a file descriptor, which stays open after shutdown
+    explicit AsyncSink(int fd, size_t capacity = 1024, OverflowPolicy overflow = OverflowPolicy::block) :
+      AsyncSink(nullptr, fd, capacity, overflow) {}
+#endif
+
+    AsyncSink(const AsyncSink&) = delete;
+    AsyncSink& operator=(const AsyncSink&) = delete;
+
+    ~AsyncSink() {
+      shutdown();
+    }
+
+    // Queues record and leaves it empty (holding a recycled buffer).
+    // Returns false if the record was dropped.
+    bool push(std::string& record) {
+      for (size_t attempt = 0; ; attempt++) {
+        if (stopped_.load(std::memory_order_acquire)) {
+          record.clear();
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        if (try_push(record))
+          break;
+        if (overflow_ == OverflowPolicy::drop_newest) {
+          record.clear();
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        if (overflow_ == OverflowPolicy::drop_oldest) {
+          if (try_pop(scratch_record()))
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (attempt < 16) {
+          std::this_thread::yield();
+        }
+        else {
+          wait_for_room();
+        }
+      }
+      wake();
+      return true;
+    }
+
+    // Waits until every record pushed before the call has been written and
+    // the stream flushed
+    void flush() {
+      const size_t target = enqueue_position_.load(std::memory_order_acquire);
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!worker_.joinable())
+        return;
+      flush_target_ = std::max(flush_target_, target);
+      wake_.notify_one();
+      flushed_.wait(lock, [&] { return flushed_position_ >= target || stopping_; });
+    }
+
+    // Writes everything queued and stops the background thread. Records
+    // pushed afterwards are dropped.
+    void shutdown() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!worker_.joinable())
+          return;
+        stopped_.store(true, std::memory_order_release);
+        stopping_ = true;
+      }
+      wake_.notify_one();
+      room_.notify_all();
+      worker_.join();
+    }
+
+    // Records discarded because the queue was full or the sink shut down
+    size_t dropped() const {
+      return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // Largest number of records that were queued at once
+    size_t high_water_mark() const {
+      return high_water_mark_.load(std::memory_order_relaxed);
+    }
+
+    size_t capacity() const {
+      return mask_ + 1;
+    }
+
+  private:
+    friend class PrettyPrinter;
+
+    struct Slot {
+      std::atomic<size_t> sequence;
+      std::string record;
+    };
+
+    AsyncSink(std::ostream * stream, int fd, size_t capacity, OverflowPolicy overflow) :
+      stream_(stream),
+      fd_(fd),
+      overflow_(overflow),
+      format_state_(nullptr) {
+      size_t size = 2;
+      while (size < capacity)
+        size *= 2;
+      mask_ = size - 1;
+      slots_ = std::make_unique<Slot[]>(size);
+      for (size_t i = 0; i < size; i++)
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+      worker_ = std::thread([this] { run(); });
+    }
+
+    // Number formatting follows the target stream; a file descriptor gets
+    // the defaults
+    std::ostream& format_state() {
+      return stream_ ? *stream_ : format_state_;
+    }
+
+    bool try_push(std::string& record) {
+      size_t position = enqueue_position_.load(std::memory_order_relaxed);
+      Slot * slot;
+      for (;;) {
+        slot = &slots_[position & mask_];
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+          if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0) {
+          return false;
+        }
+        else {
+          position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+      }
+      slot->record.swap(record);
+      record.clear();
+      slot->sequence.store(position + 1, std::memory_order_seq_cst); // see wake()
+
+      // The background thread may already have taken this record and
+      // others pushed after it, so the difference can be negative
+      const auto difference =
+        static_cast<std::ptrdiff_t>(position + 1 - dequeue_position_.load(std::memory_order_relaxed));
+      if (difference > 0) {
+        const size_t depth = std::min(static_cast<size_t>(difference), capacity());
+        size_t mark = high_water_mark_.load(std::memory_order_relaxed);
+        while (depth > mark && !high_water_mark_.compare_exchange_weak(mark, depth, std::memory_order_relaxed)) {}
+      }
+      return true;
+    }
+
+    // Swaps the oldest record into record, which should be empty
+    bool try_pop(std::string& record) {
+      size_t position = dequeue_position_.load(std::memory_order_relaxed);
+      Slot * slot;
+      for (;;) {
+        slot = &slots_[position & mask_];
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+        if (difference == 0) {
+          if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0) {
+          return false;
+        }
+        else {
+          position = dequeue_position_.load(std::memory_order_relaxed);
+        }
+      }
+      record.swap(slot->record);
+      slot->sequence.store(position + mask_ + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool writable() const {
+      const size_t position = enqueue_position_.load(std::memory_order_relaxed);
+      return slots_[position & mask_].sequence.load(std::memory_order_seq_cst) == position;
+    }
+
+    // Sleeps until a slot is freed or the sink stops. The background thread
+    // only takes the lock to wake producers while blocked_ is set; it checks
+    // after every record it takes, and the timeout covers a check that
+    // raced with this one.
+    void wait_for_room() {
+      blocked_.fetch_add(1, std::memory_order_seq_cst);
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        room_.wait_for(lock, std::chrono::milliseconds(1), [&] { return writable() || stopping_; });
+      }
+      blocked_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool readable() const {
+      const size_t position = dequeue_position_.load(std::memory_order_relaxed);
+      return slots_[position & mask_].sequence.load(std::memory_order_seq_cst) == position + 1;
+    }
+
+    // Per-thread scratch string for records dropped by drop_oldest
+    static std::string& scratch_record() {
+      thread_local std::string record;
+      record.clear();
+      return record;
+    }
+
+    // Producers only take the lock when the background thread sleeps. The
+    // record is published and sleeping_ set with sequentially consistent
+    // operations, so either the producer sees sleeping_ or the background
+    // thread sees the new record.
+    void wake() {
+      if (sleeping_.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_.notify_one();
+      }
+    }
+
+    void run() {
+      std::string record, batch;
+      for (;;) {
+        while (try_pop(record)) {
+          if (blocked_.load(std::memory_order_seq_cst) != 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            room_.notify_one();
+          }
+          batch.append(record);
+          record.clear();
+          if (batch.size() >= (1 << 16)) {
+            write(batch);
+            batch.clear();
+          }
+        }
+        if (!batch.empty()) {
+          write(batch);
+          batch.clear();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (flush_target_ > flushed_position_) {
+          // Everything below the dequeue position has been written or dropped
+          if (stream_)
+            stream_->flush();
+          flushed_position_ = dequeue_position_.load(std::memory_order_acquire);
+          flushed_.notify_all();
+          if (flush_target_ > flushed_position_) {
+            // A record being pushed has not been published yet
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+          }
+        }
+        if (stopping_ && !readable())
+          break;
+        sleeping_.store(true, std::memory_order_seq_cst);
+        wake_.wait(lock, [&] { return readable() || stopping_ || flush_target_ > flushed_position_; });
+        sleeping_.store(false, std::memory_order_relaxed);
+      }
+      if (stream_)
+        stream_->flush();
+      std::lock_guard<std::mutex> lock(mutex_);
+      flushed_position_ = dequeue_position_.load(std::memory_order_acquire);
+      flushed_.notify_all();
+    }
+
+    void write(const std::string& batch) {
+      if (stream_) {
+        stream_->write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        return;
+      }
+#if defined(__unix__) || defined(__APPLE__)
+      const char * data = batch.data();
+      size_t left = batch.size();
+      while (left > 0) {
+        const auto written = ::write(fd_, data, left);
+        if (written < 0 && errno == EINTR)
+          continue;
+        if (written <= 0)
+          return;
+        data += written;
+        left -= static_cast<size_t>(written);
+      }
+#endif
+    }
+
+    std::ostream * stream_;
+    int fd_;
+    OverflowPolicy overflow_;
+    std::ostream format_state_;
+
+    size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<size_t> enqueue_position_ {0};
+    alignas(64) std::atomic<size_t> dequeue_position_ {0};
+    alignas(64) std::atomic<size_t> dropped_ {0};
+    std::atomic<size_t> high_water_mark_ {0};
+    std::atomic<bool> stopped_ {false};
+    std::atomic<bool> sleeping_ {false};
+    std::atomic<size_t> blocked_ {0}; // producers waiting for room
+
+    // Guards the members below, used by flush, shutdown and to wake the
+    // background thread and blocked producers
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    std::condition_variable room_;
+    bool stopping_ = false;
+    size_t flush_target_ = 0;
+    size_t flushed_position_ = 0;
+    std::thread worker_;
+  };
+
+  // Size of a range that can only be known by walking it
+
+}
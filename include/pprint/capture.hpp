@@ -0,0 +1,568 @@
+// pprint/capture.hpp: reading back the captures of OutputFormat::binary
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "core.hpp"
+#include "enum.hpp"
+#include "utility.hpp"
+#include <stdexcept>
+
+namespace pprint {
+
+  // A value read back from a capture. Printing it writes what printing the
+  // captured value would have, with the settings of the printer.
+  struct CapturedValue {
+    enum class Kind : unsigned char {
+      null,             // nullptr, null pointers
+      nullopt,
+      boolean,
+      integer,          // negative integers
+      unsigned_integer, // the others
+      float32,
+      float64,
+      string,
+      character,
+      text,             // printed as it is: operator<<, pointers, objects
+      sequence,
+      set,
+      map,
+      tuple,
+      pair,
+      enumeration,
+      variant,
+      complex,
+      pointer           // a smart pointer: its text, then its pointee or null
+    };
+
+    typedef CapturedValue key_type;
+    typedef CapturedValue mapped_type;
+
+    Kind kind = Kind::null;
+    bool boolean = false;
+    std::int64_t integer = 0;          // integer, the index of a variant
+    std::uint64_t unsigned_integer = 0;
+    double real = 0;                   // float32 (a float), float64 (a double)
+    std::string text;                  // string, character, text, the name of an enumeration
+    std::vector<CapturedValue> elements; // sequence, set, tuple, pair, complex, pointer, the value
+                                         // of an enumeration or variant
+    std::vector<std::pair<CapturedValue, CapturedValue>> entries; // map
+    bool nested = false;               // the elements or values are containers
+    bool unknown_size = false;         // the array or map was indefinite: its size was unknown when printed
+    int compact = -1;                  // sequences printed on one line (1, queues), one element per
+                                       // line (0, stacks) or as the printer prints them (-1)
+
+    // The entries of a map
+    auto begin() const {
+      return entries.begin();
+    }
+
+    auto end() const {
+      return entries.end();
+    }
+  };
+
+  // Captured maps and pairs are fields of their own in logfmt
+  inline bool holds_map(const CapturedValue& value) {
+    return value.kind == CapturedValue::Kind::map;
+  }
+
+  inline bool holds_entry(const CapturedValue& value) {
+    return value.kind == CapturedValue::Kind::pair && value.elements.size() == 2;
+  }
+
+  inline const CapturedValue& entry_key(const CapturedValue& pair) {
+    return pair.elements[0];
+  }
+
+  inline const CapturedValue& entry_value(const CapturedValue& pair) {
+    return pair.elements[1];
+  }
+
+  // The values of one print, read back from a capture
+  struct CapturedRecord {
+    std::vector<CapturedValue> values;
+    bool print_inline = false;
+  };
+
+  // Reads the records of a capture in order. Data items of CBOR that
+  // pprint does not write are read as the closest kind of value, unknown
+  // tags are skipped; a capture that is not CBOR throws std::runtime_error.
+  class CaptureReader {
+  public:
+    explicit CaptureReader(std::string_view capture) : data_(capture) {}
+
+    // Reads the next record, false at the end of the capture
+    bool read(CapturedRecord& record) {
+      if (data_.empty())
+        return false;
+      record.print_inline = false;
+      if (static_cast<unsigned char>(data_[0]) >> 5 == 6) {
+        if (argument(take() & 31) != static_cast<std::uint64_t>(CaptureTag::print_inline))
+          fail();
+        record.print_inline = true;
+      }
+      CapturedValue values = read_value(0);
+      if (values.kind != CapturedValue::Kind::sequence || values.elements.empty())
+        fail();
+      record.values = std::move(values.elements);
+      return true;
+    }
+
+  private:
+    static constexpr size_t max_depth = 1000;
+
+    [[noreturn]] static void fail() {
+      throw std::runtime_error("pprint: malformed capture");
+    }
+
+    unsigned char take() {
+      if (data_.empty())
+        fail();
+      const unsigned char byte = static_cast<unsigned char>(data_[0]);
+      data_.remove_prefix(1);
+      return byte;
+    }
+
+    std::uint64_t big_endian(size_t bytes) {
+      if (data_.size() < bytes)
+        fail();
+      std::uint64_t value = 0;
+      for (size_t i = 0; i < bytes; i++)
+        value = value << 8 | static_cast<unsigned char>(data_[i]);
+      data_.remove_prefix(bytes);
+      return value;
+    }
+
+    // The argument of a head with additional information info
+    std::uint64_t argument(unsigned info) {
+      if (info < 24)
+        return info;
+      if (info > 27)
+        fail();
+      return big_endian(size_t(1) << (info - 24));
+    }
+
+    // Calls read_item once for each item of an array or map with
+    // additional information info, definite or indefinite
+    template <typename ReadItem>
+    void read_items(unsigned info, ReadItem read_item) {
+      if (info == 31) {
+        while (!data_.empty() && static_cast<unsigned char>(data_[0]) != 0xff)
+          read_item();
+        take();
+        return;
+      }
+      const std::uint64_t count = argument(info);
+      if (count > data_.size())
+        fail(); // every item takes a byte at least
+      for (std::uint64_t i = 0; i < count; i++)
+        read_item();
+    }
+
+    CapturedValue read_value(size_t depth) {
+      typedef CapturedValue::Kind Kind;
+      if (depth > max_depth)
+        fail();
+      const unsigned char initial = take();
+      const unsigned info = initial & 31;
+      CapturedValue value;
+      switch (initial >> 5) {
+      case 0:
+        value.kind = Kind::unsigned_integer;
+        value.unsigned_integer = argument(info);
+        break;
+      case 1: {
+        const std::uint64_t magnitude = argument(info);
+        if (magnitude > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+          fail();
+        value.kind = Kind::integer;
+        value.integer = -1 - static_cast<std::int64_t>(magnitude);
+        break;
+      }
+      case 2:
+      case 3: {
+        const std::uint64_t length = argument(info);
+        if (length > data_.size())
+          fail();
+        value.kind = Kind::string;
+        value.text = std::string(data_.substr(0, static_cast<size_t>(length)));
+        data_.remove_prefix(static_cast<size_t>(length));
+        break;
+      }
+      case 4:
+        value.kind = Kind::sequence;
+        value.unknown_size = info == 31;
+        read_items(info, [&] { value.elements.push_back(read_value(depth + 1)); });
+        break;
+      case 5:
+        value.kind = Kind::map;
+        value.unknown_size = info == 31;
+        read_items(info, [&] {
+          CapturedValue key = read_value(depth + 1);
+          value.entries.emplace_back(std::move(key), read_value(depth + 1));
+        });
+        break;
+      case 6:
+        return read_tagged(argument(info), depth);
+      default:
+        read_simple(value, info);
+      }
+      return value;
+    }
+
+    void read_simple(CapturedValue& value, unsigned info) {
+      typedef CapturedValue::Kind Kind;
+      switch (info) {
+      case 20:
+      case 21:
+        value.kind = Kind::boolean;
+        value.boolean = info == 21;
+        break;
+      case 22:
+        value.kind = Kind::null;
+        break;
+      case 23:
+        value.kind = Kind::nullopt; // undefined
+        break;
+      case 25: {
+        const std::uint64_t bits = big_endian(2);
+        const int exponent = static_cast<int>(bits >> 10 & 0x1f);
+        const double mantissa = static_cast<double>(bits & 0x3ff);
+        double real = exponent == 0 ? std::ldexp(mantissa, -24) :
+          exponent != 31 ? std::ldexp(mantissa + 1024, exponent - 25) :
+          mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+        value.kind = Kind::float64;
+        value.real = bits >> 15 ? -real : real;
+        break;
+      }
+      case 26: {
+        const std::uint32_t bits = static_cast<std::uint32_t>(big_endian(4));
+        float real;
+        std::memcpy(&real, &bits, sizeof(real));
+        value.kind = Kind::float64;
+        value.real = real;
+        break;
+      }
+      case 27: {
+        const std::uint64_t bits = big_endian(8);
+        value.kind = Kind::float64;
+        std::memcpy(&value.real, &bits, sizeof(value.real));
+        break;
+      }
+      default:
+        fail();
+      }
+    }
+
+    CapturedValue read_tagged(std::uint64_t tag, size_t depth) {
+      typedef CapturedValue::Kind Kind;
+      CapturedValue value = read_value(depth + 1);
+      const auto expect = [](bool condition) {
+        if (!condition)
+          fail();
+      };
+      const auto is_number = [](const CapturedValue& element) {
+        return element.kind == Kind::integer || element.kind == Kind::unsigned_integer;
+      };
+      const auto is_real = [](const CapturedValue& element) {
+        return element.kind == Kind::float32 || element.kind == Kind::float64;
+      };
+      const bool sequence = value.kind == Kind::sequence;
+      switch (static_cast<CaptureTag>(tag)) {
+      case CaptureTag::text:
+        expect(value.kind == Kind::string);
+        value.kind = Kind::text;
+        break;
+      case CaptureTag::character:
+        expect(value.kind == Kind::string && value.text.size() == 1);
+        value.kind = Kind::character;
+        break;
+      case CaptureTag::set:
+        expect(sequence);
+        value.kind = Kind::set;
+        break;
+      case CaptureTag::tuple:
+        expect(sequence);
+        value.kind = Kind::tuple;
+        break;
+      case CaptureTag::pair:
+        expect(sequence && value.elements.size() == 2);
+        value.kind = Kind::pair;
+        break;
+      case CaptureTag::enumeration:
+        expect(sequence && value.elements.size() == 2 && is_number(value.elements[0]) &&
+          value.elements[1].kind == Kind::string);
+        value.kind = Kind::enumeration;
+        value.text = std::move(value.elements[1].text);
+        value.elements.pop_back();
+        break;
+      case CaptureTag::variant:
+        expect(sequence && value.elements.size() == 2 && value.elements[0].kind == Kind::unsigned_integer);
+        value.kind = Kind::variant;
+        value.integer = static_cast<std::int64_t>(value.elements[0].unsigned_integer);
+        value.elements.erase(value.elements.begin());
+        break;
+      case CaptureTag::complex:
+        expect(sequence && value.elements.size() == 2 && is_real(value.elements[0]) &&
+          value.elements[1].kind == value.elements[0].kind);
+        value.kind = Kind::complex;
+        break;
+      case CaptureTag::pointer:
+        expect(sequence && value.elements.size() == 2 && value.elements[0].kind == Kind::text);
+        value.kind = Kind::pointer;
+        break;
+      case CaptureTag::float32:
+        expect(value.kind == Kind::float64);
+        value.kind = Kind::float32;
+        break;
+      case CaptureTag::queue:
+      case CaptureTag::stack:
+        expect(sequence);
+        value.compact = static_cast<CaptureTag>(tag) == CaptureTag::queue;
+        break;
+      case CaptureTag::nested:
+        expect(sequence || value.kind == Kind::map);
+        value.nested = true;
+        break;
+      default:
+        break;
+      }
+      return value;
+    }
+
+    std::string_view data_;
+  };
+
+  namespace category {
+    struct captured {};
+  }
+
+  template <>
+  struct category_of<CapturedValue> {
+    using type = category::captured;
+  };
+
+  template <>
+  struct category_printer<category::captured> {
+    static void print(PrettyPrinter& printer, const CapturedValue& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      typedef CapturedValue::Kind Kind;
+      switch (value.kind) {
+      case Kind::null:
+        printer.print_internal(nullptr, indent, line_terminator, level);
+        break;
+      case Kind::nullopt:
+        printer.print_internal(std::optional<int>(), indent, line_terminator, level);
+        break;
+      case Kind::boolean:
+        printer.print_internal(value.boolean, indent, line_terminator, level);
+        break;
+      case Kind::integer:
+        printer.print_internal(value.integer, indent, line_terminator, level);
+        break;
+      case Kind::unsigned_integer:
+        printer.print_internal(value.unsigned_integer, indent, line_terminator, level);
+        break;
+      case Kind::float32:
+        printer.print_internal(static_cast<float>(value.real), indent, line_terminator, level);
+        break;
+      case Kind::float64:
+        printer.print_internal(value.real, indent, line_terminator, level);
+        break;
+      case Kind::string:
+        printer.print_string(value.text, indent, line_terminator, level);
+        break;
+      case Kind::character:
+        printer.print_internal(value.text.empty() ? '\0' : value.text[0], indent, line_terminator, level);
+        break;
+      case Kind::text:
+        printer.print_internal(FlatText {value.text.data(), value.text.size()}, indent, line_terminator, level);
+        break;
+      case Kind::sequence:
+      case Kind::set:
+        if (value.compact >= 0)
+          printer.write_tag(value.compact ? CaptureTag::queue : CaptureTag::stack);
+        printer.print_elements(value.elements.begin(), value.elements.end(),
+          value.unknown_size ? unknown_size : value.elements.size(),
+          value.kind == Kind::set ? "{" : "[", value.kind == Kind::set ? "}" : "]", value.nested,
+          printer.element_printer(level), indent, level, value.compact >= 0 ? value.compact == 1 : printer.compact_);
+        break;
+      case Kind::map:
+        printer.print_entries(value.entries.begin(), value.entries.end(),
+          value.unknown_size ? unknown_size : value.entries.size(), value.nested, indent, level, printer.compact_);
+        break;
+      case Kind::tuple:
+        print_tuple(printer, value, indent, line_terminator, level);
+        break;
+      case Kind::pair:
+        if (value.elements.size() == 2)
+          printer.print_pair(value.elements[0], value.elements[1], indent, line_terminator, level);
+        break;
+      case Kind::enumeration:
+        if (!value.elements.empty())
+          print_enumerator(printer, value, indent, line_terminator, level);
+        break;
+      case Kind::variant:
+        if (!value.elements.empty()) {
+          category_printer<category::variant>::print_alternative(printer, static_cast<size_t>(value.integer),
+            value.elements[0], indent, line_terminator, level);
+        }
+        break;
+      case Kind::complex:
+        if (value.elements.size() != 2)
+          break;
+        if (value.elements[0].kind == Kind::float32) {
+          printer.print_internal(std::complex<float>(static_cast<float>(value.elements[0].real),
+            static_cast<float>(value.elements[1].real)), indent, line_terminator, level);
+        }
+        else {
+          printer.print_internal(std::complex<double>(value.elements[0].real, value.elements[1].real), indent,
+            line_terminator, level);
+        }
+        break;
+      case Kind::pointer:
+        if (value.elements.size() == 2)
+          print_pointer(printer, value, indent, line_terminator, level);
+        break;
+      }
+    }
+
+    // Prints record as the print or print_inline it was captured from
+    static void print_record(PrettyPrinter& printer, const CapturedRecord& record) {
+      printer.record([&](PrettyPrinter& printer) {
+        printer.print_argument_list(record.print_inline ? printer.indent_ : 0,
+          record.print_inline ? std::string_view() : std::string_view(printer.line_terminator_),
+          record.values.size(), [&](auto&& print_one) {
+            for (size_t index = 0; index < record.values.size(); index++)
+              print_one(record.values[index], index);
+          });
+      });
+    }
+
+  private:
+    // As PrettyPrinter prints smart pointers: the captured text in text,
+    // the pointee otherwise
+    static void print_pointer(PrettyPrinter& printer, const CapturedValue& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      const CapturedValue& text = value.elements[0];
+      if (printer.format_ == OutputFormat::text) {
+        printer.print_internal(FlatText {text.text.data(), text.text.size()}, indent, line_terminator, level);
+      }
+      else if (printer.format_ == OutputFormat::binary) {
+        printer.write_indent(indent);
+        printer.write_tag(CaptureTag::pointer);
+        printer.begin_array(2);
+        printer.print_internal(text, 0, "", level);
+        printer.print_internal(value.elements[1], 0, "", level);
+        printer.end_array(2);
+        printer.write(line_terminator);
+      }
+      else {
+        printer.write_indent(indent);
+        printer.print_internal(value.elements[1], 0, "", level);
+        printer.write(line_terminator);
+      }
+    }
+
+    static void print_enumerator(PrettyPrinter& printer, const CapturedValue& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      const CapturedValue& number = value.elements[0];
+      printer.write_indent(indent);
+      if (printer.format_ != OutputFormat::text) {
+        if (number.kind == CapturedValue::Kind::integer)
+          category_printer<category::enumeration>::write_enumerator(printer, value.text, number.integer, level);
+        else
+          category_printer<category::enumeration>::write_enumerator(printer, value.text, number.unsigned_integer,
+            level);
+      }
+      else if (!value.text.empty()) {
+        printer.write(value.text);
+      }
+      else if (number.kind == CapturedValue::Kind::integer) {
+        printer.write_formatted(number.integer);
+      }
+      else {
+        printer.write_formatted(number.unsigned_integer);
+      }
+      printer.write(line_terminator);
+    }
+
+    static void print_tuple(PrettyPrinter& printer, const CapturedValue& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      const size_t size = value.elements.size();
+      printer.write_indent(indent);
+      if (printer.format_ != OutputFormat::text) {
+        printer.write_tag(CaptureTag::tuple);
+        printer.begin_array(size);
+      }
+      else {
+        printer.write('(');
+      }
+      for (size_t index = 0; index < size; index++)
+        print_tuple_element(printer, value.elements[index], index, level);
+      if (printer.format_ != OutputFormat::text)
+        printer.end_array(size);
+      else
+        printer.write(')');
+      printer.write(line_terminator);
+    }
+
+    // As PrettyPrinter::print_tuple_element printed the captured element
+    static void print_tuple_element(PrettyPrinter& printer, const CapturedValue& element, size_t index,
+        size_t level) {
+      typedef CapturedValue::Kind Kind;
+      if (printer.format_ != OutputFormat::text) {
+        printer.separate(index);
+        printer.print_internal(element, 0, "", level + 1);
+        return;
+      }
+      if (index > 0)
+        printer.write(", ");
+      switch (element.kind) {
+      case Kind::character:
+        printer.write('\'');
+        printer.write_escaped(element.text, '\'');
+        printer.write('\'');
+        break;
+      case Kind::string:
+        printer.write('"');
+        printer.write_string(element.text, '"');
+        printer.write('"');
+        break;
+      case Kind::integer:
+        printer.write_number(element.integer);
+        break;
+      case Kind::unsigned_integer:
+        printer.write_number(element.unsigned_integer);
+        break;
+      case Kind::float32:
+        printer.write_number(static_cast<float>(element.real));
+        break;
+      case Kind::float64:
+        printer.write_number(element.real);
+        break;
+      case Kind::boolean:
+        printer.write_formatted(element.boolean);
+        break;
+      case Kind::text:
+        printer.write(element.text);
+        break;
+      default:
+        printer.print_internal(element, 0, "", level + 1);
+      }
+    }
+  };
+
+  // Prints the records of capture with printer, each as the print or
+  // print_inline it was captured from, in printer's output format
+  inline void render(std::string_view capture, PrettyPrinter& printer) {
+    printer.flush();
+    CaptureReader reader(capture);
+    CapturedRecord record;
+    while (reader.read(record))
+      category_printer<category::captured>::print_record(printer, record);
+  }
+
+}
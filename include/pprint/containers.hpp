@@ -0,0 +1,72 @@
+// pprint/containers.hpp: sets and maps, with the standard container headers
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "core.hpp"
+#include <list>
+#include <deque>
+#include <array>
+#include <set>
+#include <unordered_set>
+#include <map>
+#include <unordered_map>
+
+namespace pprint {
+
+  template <>
+  struct category_printer<category::set> {
+    template <typename Container>
+    static void print(PrettyPrinter& printer, const Container& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      typedef typename Container::value_type T;
+      printer.print_elements(value.begin(), value.end(), value.size(), "{", "}", is_container<T>::value,
+        printer.element_printer(level), indent, level, printer.compact_);
+    }
+  };
+
+  template <>
+  struct category_printer<category::map> {
+    template <typename Map>
+    static void print(PrettyPrinter& printer, const Map& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      typedef typename Map::mapped_type Value;
+      printer.print_entries(value.begin(), value.end(), value.size(), is_container<Value>::value, indent, level,
+        printer.compact_);
+    }
+  };
+
+  // Sets are deferred as curly sequences
+  template <typename Container>
+  struct flat<Container, std::enable_if_t<(is_specialization<Container, std::set>::value ||
+      is_specialization<Container, std::multiset>::value || is_specialization<Container, std::unordered_set>::value ||
+      is_specialization<Container, std::unordered_multiset>::value) &&
+      has_arena_flat<typename Container::value_type>::value>> {
+    typedef typename Container::value_type T;
+    typedef FlatSequence<typename flat<T>::type, true, is_container<T>::value> type;
+    static type make(const Container& value, Arena& arena) {
+      return type {flat_elements<typename flat<T>::type, false>(value, value.size(), arena), value.size()};
+    }
+  };
+
+  template <typename Map>
+  struct flat<Map, std::enable_if_t<(is_specialization<Map, std::map>::value ||
+      is_specialization<Map, std::multimap>::value || is_specialization<Map, std::unordered_map>::value ||
+      is_specialization<Map, std::unordered_multimap>::value) &&
+      has_arena_flat<typename Map::key_type>::value && has_arena_flat<typename Map::mapped_type>::value>> {
+    typedef typename flat<typename Map::key_type>::type Key;
+    typedef typename flat<typename Map::mapped_type>::type Value;
+    typedef FlatMap<Key, Value, is_container<typename Map::mapped_type>::value> type;
+    static type make(const Map& value, Arena& arena) {
+      FlatEntry<Key, Value> * data = arena.allocate_array<FlatEntry<Key, Value>>(value.size());
+      size_t i = 0;
+      for (const auto& entry : value) {
+        new (data + i++) FlatEntry<Key, Value> {flat<typename Map::key_type>::make(entry.first, arena),
+          flat<typename Map::mapped_type>::make(entry.second, arena)};
+      }
+      return type {data, value.size()};
+    }
+  };
+
+}
@@ -0,0 +1,3341 @@
+/*
+ _______  _______  ______    ___   __    _  _______
+|       ||       ||    _ |  |   | |  |  | ||       |
+|    _  ||    _  ||   | ||  |   | |   |_| ||_     _|
+|   |_| ||   |_| ||   |_||_ |   | |       |  |   |
+|    ___||    ___||    __  ||   | |  _    |  |   |
+|   |    |   |    |   |  | ||   | | | |   |  |   |
+|___|    |___|    |___|  |_||___| |_|  |__|  |___|
+
+Pretty Printer for Modern C++
+https://github.com/p-ranav/pprint
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <iostream>
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <optional>
+#include <variant>
+#include <complex>
+#include <queue>
+#include <stack>
+#include <utility>
+#include <tuple>
+#include <initializer_list>
+#include <iterator>
+#include <charconv>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <memory>
+#include <exception>
+#include <mutex>
+#ifdef __GNUG__
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+#include "escape.hpp"
+#include "thread_pool.hpp"
+#include "async_sink.hpp"
+
+// Deferred printers print values they cannot copy (see is_deferrable) right
+// away, after their pending records. Define PPRINT_STRICT_DEFERRED=1 to make
+// printing such a value a compile error instead. Deferral is a runtime
+// setting, so this applies to every print in the translation unit.
+#if !defined(PPRINT_STRICT_DEFERRED)
+#  define PPRINT_STRICT_DEFERRED 0
+#endif
+
+// Check if a type is stream writable, i.e., std::cout << foo;
+template<typename S, typename T, typename = void>
+struct is_to_stream_writable: std::false_type {};
+
+template<typename S, typename T>
+struct is_to_stream_writable<S, T,
+           std::void_t<  decltype( std::declval<S&>()<<std::declval<T>() ) >>
+  : std::true_type {};
+
+
+// Printing std::tuple
+// The indices trick: http://loungecpp.wikidot.com/tips-and-tricks:indices
+namespace pprint {
+
+  template<std::size_t...> struct seq{};
+
+  template<std::size_t N, std::size_t... Is>
+  struct gen_seq : gen_seq<N-1, N-1, Is...>{};
+
+  template<std::size_t... Is>
+  struct gen_seq<0, Is...> : seq<Is...>{};
+
+  template<class Ch, class Tr, typename T>
+  inline void print_tuple_element(std::basic_ostream<Ch,Tr>& os, const T& value) {
+    os << value;
+  }
+
+  template<class Ch, class Tr>
+  inline void print_tuple_element(std::basic_ostream<Ch,Tr>& os, char value) {
+    os << '\'' << value << '\'';
+  }
+
+  template<class Ch, class Tr>
+  inline void print_tuple_element(std::basic_ostream<Ch,Tr>& os, const char * value) {
+    os << '"' << value << '"';
+  }
+
+  template<class Ch, class Tr>
+  inline void print_tuple_element(std::basic_ostream<Ch,Tr>& os, const std::string& value) {
+    os << '"' << value << '"';
+  }
+
+  template<class Ch, class Tr, class Tuple, std::size_t... Is>
+  void print_tuple(std::basic_ostream<Ch,Tr>& os, Tuple const& t, seq<Is...>){
+    using swallow = int[];
+    (void)swallow{0, (void(os << (Is == 0? "" : ", ")), print_tuple_element(os, std::get<Is>(t)), 0)...};
+  }
+
+}
+
+template<class Ch, class Tr, class... Args>
+auto operator<<(std::basic_ostream<Ch, Tr>& os, std::tuple<Args...> const& t)
+  -> std::basic_ostream<Ch, Tr>& {
+  os << "(";
+  pprint::print_tuple(os, t, pprint::gen_seq<sizeof...(Args)>());
+  return os << ")";
+}
+
+namespace pprint {
+
+  // Some utility structs to check template specialization
+  template<typename Test, template<typename...> class Ref>
+  struct is_specialization : std::false_type {};
+
+  template<template<typename...> class Ref, typename... Args>
+  struct is_specialization<Ref<Args...>, Ref> : std::true_type {};
+
+  template<typename ...>
+  using to_void = void;
+
+  template<typename T, typename = void>
+  struct is_container : std::false_type
+  {};
+
+  template<typename T>
+  struct is_container<T,
+          to_void<decltype(std::declval<T>().begin()),
+              decltype(std::declval<T>().end()),
+              typename T::value_type
+          >> : std::true_type // will  be enabled for iterable objects
+  {};
+
+  // std::streambuf that appends everything written through it to a std::string
+  class StringBuffer : public std::streambuf {
+  public:
+    explicit StringBuffer(std::string& target) : target_(&target) {}
+
+    void target(std::string& value) {
+      target_ = &value;
+    }
+
+  protected:
+    int_type overflow(int_type c) override {
+      if (!traits_type::eq_int_type(c, traits_type::eof()))
+        target_->push_back(traits_type::to_char_type(c));
+      return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char_type * s, std::streamsize n) override {
+      target_->append(s, static_cast<size_t>(n));
+      return n;
+    }
+
+  private:
+    std::string* target_;
+  };
+
+  struct identity {
+    template <typename T>
+    const T& operator()(const T& value) const {
+      return value;
+    }
+  };
+
+  // Records of thread-safe printers are written to a stream under one of
+  // these locks, picked by the address of the stream, so that printers
+  // sharing a stream never interleave and unrelated streams rarely contend
+  inline std::mutex& stream_mutex(const std::ostream& stream) {
+    static std::mutex mutexes[64];
+    const auto address = reinterpret_cast<std::uintptr_t>(&stream);
+    return mutexes[address / alignof(std::max_align_t) % 64];
+  }
+
+  inline constexpr std::size_t unknown_size = std::numeric_limits<std::size_t>::max();
+
+  // Whether Iterator is at least a Tag iterator
+  template <typename Iterator, typename Tag, typename = void>
+  struct has_iterator_category : std::false_type {};
+
+  template <typename Iterator, typename Tag>
+  struct has_iterator_category<Iterator, Tag,
+      std::void_t<typename std::iterator_traits<Iterator>::iterator_category>>
+    : std::is_base_of<Tag, typename std::iterator_traits<Iterator>::iterator_category> {};
+
+  // Keeps the element an iterator pointed at after the iterator has moved
+  // on, so that a range can be looked into one element ahead. Multi-pass
+  // iterators keep a copy of the iterator, single-pass ones a copy of the
+  // element.
+  template <typename Iterator,
+      bool MultiPass = has_iterator_category<Iterator, std::forward_iterator_tag>::value>
+  class Lookahead {
+  public:
+    void take(Iterator& first) {
+      current_.emplace(first);
+      ++first;
+    }
+
+    decltype(auto) get() const {
+      return **current_;
+    }
+
+  private:
+    std::optional<Iterator> current_;
+  };
+
+  template <typename Iterator>
+  class Lookahead<Iterator, false> {
+  public:
+    void take(Iterator& first) {
+      current_.emplace(*first);
+      ++first;
+    }
+
+    const auto& get() const {
+      return *current_;
+    }
+
+  private:
+    std::optional<std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Iterator&>())>>> current_;
+  };
+
+  // An iterator and a sentinel to be printed like a std::vector, see
+  // pprint::range. Single-pass ranges can only be printed once.
+  template <typename Iterator, typename Sentinel = Iterator>
+  class Range {
+  public:
+    Range(Iterator first, Sentinel last) : first_(std::move(first)), last_(std::move(last)) {}
+
+    Iterator begin() const {
+      if constexpr (std::is_copy_constructible_v<Iterator>)
+        return first_;
+      else
+        return std::move(first_);
+    }
+
+    Sentinel end() const {
+      return last_;
+    }
+
+    // Number of elements when it can be known without walking the range
+    size_t size() const {
+      if constexpr (std::is_same_v<Iterator, Sentinel> &&
+          has_iterator_category<Iterator, std::random_access_iterator_tag>::value)
+        return static_cast<size_t>(last_ - first_);
+      else
+        return unknown_size;
+    }
+
+  private:
+    mutable Iterator first_;
+    Sentinel last_;
+  };
+
+  // Prints the elements of [first, last) as they are produced, e.g.,
+  // printer.print(pprint::range(std::istream_iterator<int>(in), {}))
+  template <typename Iterator, typename Sentinel>
+  Range<Iterator, Sentinel> range(Iterator first, Sentinel last) {
+    return Range<Iterator, Sentinel>(std::move(first), std::move(last));
+  }
+
+  // Prints any range, including ones that cannot be iterated when const
+  // (e.g., C++20 views)
+  template <typename R>
+  auto range(R&& value) {
+    return range(std::begin(value), std::end(value));
+  }
+
+  // Anything with begin() and end()
+  template <typename T, typename = void>
+  struct is_range : std::false_type {};
+
+  template <typename T>
+  struct is_range<T, std::void_t<decltype(std::begin(std::declval<const T&>()) != std::end(std::declval<const T&>()))>>
+    : std::true_type {};
+
+  // Members that tell the kinds of containers apart, checked for all that
+  // the printer of each kind uses
+  template <typename T, typename = void>
+  struct has_key_type : std::false_type {};
+
+  template <typename T>
+  struct has_key_type<T, std::void_t<typename T::key_type>> : std::true_type {};
+
+  template <typename T, typename = void>
+  struct has_sized_elements : std::false_type {};
+
+  template <typename T>
+  struct has_sized_elements<T, std::void_t<typename T::value_type, decltype(std::declval<const T&>().size())>>
+    : std::true_type {};
+
+  template <typename T, typename = void>
+  struct has_entries : std::false_type {};
+
+  template <typename T>
+  struct has_entries<T, std::void_t<typename T::mapped_type>> : is_specialization<typename T::value_type, std::pair> {};
+
+  // Tags for the ways a class type is printed, one print_internal overload
+  // each. Class types without an overload of their own are printed by
+  // exactly one of these. The tags from enumeration on are printed by the
+  // family headers named next to them.
+  namespace category {
+    struct sequence {};
+    struct smart_pointer {};
+    struct streamable {};
+    struct range {};
+    struct object {};
+    struct enumeration {};    // pprint/enum.hpp
+    struct set {};            // pprint/containers.hpp
+    struct map {};            // pprint/containers.hpp
+    struct queue {};          // pprint/adapters.hpp
+    struct priority_queue {}; // pprint/adapters.hpp
+    struct stack {};          // pprint/adapters.hpp
+    struct variant {};        // pprint/utility.hpp
+    struct complex {};        // pprint/utility.hpp
+  }
+
+  // category_of<T>::type is the tag T is printed with. Standard library
+  // types are matched by specialization, so that a type gets the same
+  // category whichever pprint headers are included; any other class by
+  // what it has: operator<<, then iteration (sized ranges with a key_type
+  // as maps or sets, other sized ranges as sequences), then nothing
+  // (printed as <Object T>). Later checks are not instantiated once an
+  // earlier one matches.
+  template <typename T, bool = is_range<T>::value>
+  struct range_category {
+    using type = category::object;
+  };
+
+  template <typename T>
+  struct range_category<T, true> {
+    using type = std::conditional_t<!has_sized_elements<T>::value, category::range,
+      std::conditional_t<!has_key_type<T>::value, category::sequence,
+        std::conditional_t<has_entries<T>::value, category::map, category::set>>>;
+  };
+
+  template <typename T, bool Streamable = is_to_stream_writable<std::ostream, T>::value>
+  struct class_category {
+    using type = category::streamable;
+  };
+
+  template <typename T>
+  struct class_category<T, false> : range_category<T> {};
+
+  template <typename T>
+  struct category_of : class_category<T> {};
+
+  template <typename... Args>
+  struct category_of<std::vector<Args...>> {
+    using type = category::sequence;
+  };
+
+  template <typename T>
+  struct category_of<std::complex<T>> {
+    using type = category::complex;
+  };
+
+  template <typename... Args>
+  struct category_of<std::queue<Args...>> {
+    using type = category::queue;
+  };
+
+  template <typename... Args>
+  struct category_of<std::priority_queue<Args...>> {
+    using type = category::priority_queue;
+  };
+
+  template <typename... Args>
+  struct category_of<std::stack<Args...>> {
+    using type = category::stack;
+  };
+
+  // Smart pointers that can be dereferenced to something printable
+  template <typename Pointer, typename = void>
+  struct has_pointee : std::false_type {};
+
+  template <typename Pointer>
+  struct has_pointee<Pointer, std::enable_if_t<!std::is_void_v<typename Pointer::element_type>,
+      std::void_t<decltype(*std::declval<const Pointer&>())>>> : std::true_type {};
+
+  template <typename... Args>
+  struct category_of<std::unique_ptr<Args...>> {
+    using type = category::smart_pointer;
+  };
+
+  template <typename... Args>
+  struct category_of<std::shared_ptr<Args...>> {
+    using type = category::smart_pointer;
+  };
+
+  template <typename... Args>
+  struct category_of<std::weak_ptr<Args...>> {
+    using type = category::smart_pointer;
+  };
+
+  template <typename... Args>
+  struct category_of<std::variant<Args...>> {
+    using type = category::variant;
+  };
+
+  // category_printer<Tag>::print(printer, value, indent, line_terminator,
+  // level) prints the types of a category that PrettyPrinter has no
+  // overload for. The family headers specialize it next to their tags.
+  template <typename Category>
+  struct category_printer {
+    static_assert(sizeof(Category) == 0,
+      "pprint: include <pprint.hpp>, or pprint/containers.hpp for sets and maps, pprint/adapters.hpp for "
+      "queues and stacks, pprint/enum.hpp for enums, pprint/utility.hpp for variants and complex numbers");
+  };
+
+  // Bump allocator for deferred printing. Memory comes from blocks that are
+  // kept when the arena is reset, so steady-state captures do not allocate.
+  class Arena {
+  public:
+    explicit Arena(size_t block_size = 1 << 16) : block_size_(block_size) {}
+
+    void * allocate(size_t size, size_t alignment) {
+      for (;;) {
+        for (; current_ < blocks_.size(); current_++, used_ = 0) {
+          Block& block = blocks_[current_];
+          const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+          const size_t offset = (base + used_ + alignment - 1) / alignment * alignment - base;
+          if (offset + size <= block.size) {
+            used_ = offset + size;
+            return block.data.get() + offset;
+          }
+        }
+        const size_t block_size = std::max(block_size_, size + alignment);
+        blocks_.push_back(Block {std::make_unique<unsigned char[]>(block_size), block_size});
+      }
+    }
+
+    template <typename T>
+    T * allocate_array(size_t count) {
+      return count == 0 ? nullptr : static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void reset() {
+      current_ = 0;
+      used_ = 0;
+    }
+
+    // Allocates the first block up front
+    void reserve() {
+      if (blocks_.empty())
+        blocks_.push_back(Block {std::make_unique<unsigned char[]>(block_size_), block_size_});
+    }
+
+  private:
+    struct Block {
+      std::unique_ptr<unsigned char[]> data;
+      size_t size;
+    };
+    size_t block_size_;
+    std::vector<Block> blocks_;
+    size_t current_ = 0;
+    size_t used_ = 0;
+  };
+
+  // Deferred printing keeps a "flat" copy of every argument in an Arena:
+  // scalars and other trivially copyable values as they are, strings,
+  // containers, arrays and views as arrays in the arena (one memcpy when
+  // the elements are trivially copyable), and pairs, tuples, optionals and
+  // variants as the flat copies of what they hold. The flat types are
+  // printed exactly like the originals.
+  struct FlatString {
+    const char * data;
+    size_t size;
+  };
+
+  // std::string_view, printed as is
+  struct FlatText {
+    const char * data;
+    size_t size;
+  };
+
+  template <typename Element, bool Curly, bool ContainerElements>
+  struct FlatSequence {
+    const Element * data;
+    size_t size;
+    bool unknown_size = false; // printed as a range of unknown size, see print_elements
+  };
+
+  template <typename Key, typename Value>
+  struct FlatEntry {
+    Key key;
+    Value value;
+  };
+
+  template <typename Key, typename Value, bool ContainerValues>
+  struct FlatMap {
+    typedef Key key_type;
+    typedef Value mapped_type;
+
+    const FlatEntry<Key, Value> * data;
+    size_t size;
+
+    const FlatEntry<Key, Value> * begin() const {
+      return data;
+    }
+
+    const FlatEntry<Key, Value> * end() const {
+      return data + size;
+    }
+  };
+
+  // Key and value of an entry of a map or of its flat copy
+  template <typename Key, typename Value>
+  const Key& entry_key(const std::pair<Key, Value>& entry) {
+    return entry.first;
+  }
+
+  template <typename Key, typename Value>
+  const Value& entry_value(const std::pair<Key, Value>& entry) {
+    return entry.second;
+  }
+
+  template <typename Key, typename Value>
+  const Key& entry_key(const FlatEntry<Key, Value>& entry) {
+    return entry.key;
+  }
+
+  template <typename Key, typename Value>
+  const Value& entry_value(const FlatEntry<Key, Value>& entry) {
+    return entry.value;
+  }
+
+  // Ranges of entries with a key_type and a mapped_type: the standard
+  // maps, their flat copies and maps alike
+  template <typename T, typename = void>
+  struct is_map : std::false_type {};
+
+  template <typename T>
+  struct is_map<T, std::void_t<typename T::key_type, typename T::mapped_type,
+      decltype(entry_key(*std::begin(std::declval<const T&>())))>> : is_range<T> {};
+
+  // Types with an entry_key and an entry_value, like std::pair
+  template <typename T, typename = void>
+  struct is_entry : std::false_type {};
+
+  template <typename T>
+  struct is_entry<T, std::void_t<decltype(entry_key(std::declval<const T&>()))>> : std::true_type {};
+
+  // Whether a map or entry holds one: always, except for types that hold
+  // values of any kind, which overload these (see pprint/capture.hpp)
+  template <typename T>
+  constexpr bool holds_map(const T&) {
+    return true;
+  }
+
+  template <typename T>
+  constexpr bool holds_entry(const T&) {
+    return true;
+  }
+
+  // flat<T>::make(value, arena) returns the flat copy of value. Types
+  // without a flat form are copied as they are, if that is safe (see
+  // is_deferrable).
+  template <typename T, typename = void>
+  struct flat {};
+
+  template <typename T, typename = void>
+  struct has_flat : std::false_type {};
+
+  template <typename T>
+  struct has_flat<T, std::void_t<typename flat<T>::type>> : std::true_type {};
+
+  // Flat forms that can be kept in the arena, which never destroys them
+  template <typename T, typename = void>
+  struct has_arena_flat : std::false_type {};
+
+  template <typename T>
+  struct has_arena_flat<T, std::enable_if_t<std::is_trivially_destructible_v<typename flat<T>::type>>>
+    : std::true_type {};
+
+  // Pointers to characters, which operator<< writes as strings
+  template <typename T>
+  struct is_char_pointer : std::bool_constant<std::is_pointer_v<T> &&
+    (std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char> ||
+     std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, signed char> ||
+     std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, unsigned char>)> {};
+
+  // Types whose copies refer to what they print without owning it: pointers
+  // to characters, string views, pprint::Range and the other trivially
+  // copyable ranges (spans, views, initializer_lists, and std::array, which
+  // is only copied element by element)
+  template <typename T>
+  struct is_view : std::bool_constant<is_char_pointer<T>::value || std::is_same_v<T, std::string_view> ||
+    is_specialization<T, Range>::value || (std::is_trivially_copyable_v<T> && is_range<T>::value)> {};
+
+  // Standard types that hold values of other types, whose flat forms hold
+  // the deferred forms of those
+  template <typename T>
+  struct is_holder : std::bool_constant<is_specialization<T, std::pair>::value ||
+    is_specialization<T, std::tuple>::value || is_specialization<T, std::optional>::value ||
+    is_specialization<T, std::variant>::value> {};
+
+  // Whether a copy of a T owns everything printing it reads, so deferred
+  // printing can keep the copy. Containers, optionals, pairs, tuples and
+  // variants claim to be copy constructible whatever they hold, so what
+  // they hold is checked too. Class types of your own are trusted to own
+  // what they print: print views of your own without deferring them.
+  template <typename T, typename = void>
+  struct is_copy_safe : std::bool_constant<std::is_copy_constructible_v<T> && !std::is_reference_v<T> &&
+    !std::is_array_v<T> && !is_view<T>::value> {};
+
+  template <typename T>
+  struct is_copy_safe<T, std::enable_if_t<!std::is_same_v<typename T::value_type, T> &&
+      !is_specialization<T, std::initializer_list>::value>>
+    : std::bool_constant<std::is_copy_constructible_v<T> && !is_view<T>::value &&
+      is_copy_safe<std::remove_cv_t<typename T::value_type>>::value> {};
+
+  // Copied into a std::vector, see deferred
+  template <typename T>
+  struct is_copy_safe<std::initializer_list<T>> : is_copy_safe<T> {};
+
+  template <typename First, typename Second>
+  struct is_copy_safe<std::pair<First, Second>>
+    : std::bool_constant<is_copy_safe<First>::value && is_copy_safe<Second>::value> {};
+
+  template <typename... Types>
+  struct is_copy_safe<std::tuple<Types...>> : std::bool_constant<(is_copy_safe<Types>::value && ...)> {};
+
+  template <typename... Types>
+  struct is_copy_safe<std::variant<Types...>> : std::bool_constant<(is_copy_safe<Types>::value && ...)> {};
+
+  // Whether deferred printing can keep a T: as its flat form, or else as a
+  // copy that owns what it prints
+  template <typename T>
+  struct is_deferrable : std::bool_constant<has_flat<T>::value || is_copy_safe<T>::value> {};
+
+  // How deferred printing stores a T: its flat form, or else a copy
+  template <typename T, bool = has_flat<T>::value>
+  struct deferred {
+    typedef T type;
+  };
+
+  template <typename T>
+  struct deferred<T, true> {
+    typedef typename flat<T>::type type;
+  };
+
+  // An initializer_list does not own its elements
+  template <typename T>
+  struct deferred<std::initializer_list<T>, false> {
+    typedef std::vector<T> type;
+  };
+
+  // How deferred printing stores what a pair, tuple, optional or variant holds
+  template <typename T>
+  using deferred_t = typename deferred<std::remove_cv_t<std::remove_reference_t<T>>>::type;
+
+  template <typename T>
+  deferred_t<T> defer_value(const T& value, Arena& arena) {
+    if constexpr (has_flat<T>::value)
+      return flat<T>::make(value, arena);
+    else
+      return deferred_t<T>(value);
+  }
+
+  template <typename T>
+  struct flat<T, std::enable_if_t<std::is_trivially_copyable_v<T> && !std::is_array_v<T> &&
+      !is_view<T>::value && !is_holder<T>::value>> {
+    typedef T type;
+    static T make(const T& value, Arena&) {
+      return value;
+    }
+  };
+
+  inline FlatString flat_string(std::string_view value, Arena& arena) {
+    char * data = arena.allocate_array<char>(value.size());
+    if (!value.empty())
+      std::memcpy(data, value.data(), value.size());
+    return FlatString {data, value.size()};
+  }
+
+  // Other pointers to characters are printed as pointers that show their
+  // string, and are not deferred
+  template <>
+  struct flat<const char *> {
+    typedef FlatString type;
+    static FlatString make(const char * value, Arena& arena) {
+      return flat_string(value ? std::string_view(value) : std::string_view(), arena);
+    }
+  };
+
+  template <>
+  struct flat<std::string> {
+    typedef FlatString type;
+    static FlatString make(const std::string& value, Arena& arena) {
+      return flat_string(value, arena);
+    }
+  };
+
+  template <>
+  struct flat<std::string_view> {
+    typedef FlatText type;
+    static FlatText make(std::string_view value, Arena& arena) {
+      const FlatString copy = flat_string(value, arena);
+      return FlatText {copy.data, copy.size};
+    }
+  };
+
+  template <typename First, typename Second>
+  struct flat<std::pair<First, Second>, std::enable_if_t<is_deferrable<std::remove_cv_t<First>>::value &&
+      is_deferrable<std::remove_cv_t<Second>>::value>> {
+    typedef std::pair<deferred_t<First>, deferred_t<Second>> type;
+    static type make(const std::pair<First, Second>& value, Arena& arena) {
+      return type(defer_value(value.first, arena), defer_value(value.second, arena));
+    }
+  };
+
+  template <typename... Types>
+  struct flat<std::tuple<Types...>, std::enable_if_t<(is_deferrable<
+      std::remove_cv_t<std::remove_reference_t<Types>>>::value && ...)>> {
+    typedef std::tuple<deferred_t<Types>...> type;
+    static type make(const std::tuple<Types...>& value, Arena& arena) {
+      return std::apply([&arena](const auto&... element) { return type(defer_value(element, arena)...); }, value);
+    }
+  };
+
+  template <typename T>
+  struct flat<std::optional<T>, std::enable_if_t<is_deferrable<std::remove_cv_t<T>>::value>> {
+    typedef std::optional<deferred_t<T>> type;
+    static type make(const std::optional<T>& value, Arena& arena) {
+      return value ? type(defer_value(*value, arena)) : type();
+    }
+  };
+
+  template <typename... Types>
+  struct flat<std::variant<Types...>, std::enable_if_t<(is_deferrable<std::remove_cv_t<Types>>::value && ...)>> {
+    typedef std::variant<deferred_t<Types>...> type;
+    static type make(const std::variant<Types...>& value, Arena& arena) {
+      return make(value, arena, std::index_sequence_for<Types...>());
+    }
+
+    // The flat copy holds the alternative of the same index, as
+    // alternatives of a variant may have the same type
+    template <std::size_t... Indices>
+    static type make(const std::variant<Types...>& value, Arena& arena, std::index_sequence<Indices...>) {
+      typedef type (*Make)(const std::variant<Types...>&, Arena&);
+      static constexpr Make alternatives[] = {&make_alternative<Indices>...};
+      if (value.valueless_by_exception())
+        throw std::bad_variant_access();
+      return alternatives[value.index()](value, arena);
+    }
+
+    template <std::size_t Index>
+    static type make_alternative(const std::variant<Types...>& value, Arena& arena) {
+      return type(std::in_place_index<Index>, defer_value(*std::get_if<Index>(&value), arena));
+    }
+  };
+
+  // Copies the elements of value into an array in the arena. Contiguous
+  // containers of trivially copyable elements take a single memcpy.
+  template <typename Element, bool Contiguous, typename Container>
+  const Element * flat_elements(const Container& value, size_t size, Arena& arena) {
+    typedef typename std::iterator_traits<decltype(std::begin(value))>::value_type T;
+    Element * data = arena.allocate_array<Element>(size);
+    if constexpr (Contiguous && std::is_same_v<Element, T>) {
+      if (size > 0)
+        std::memcpy(static_cast<void*>(data), std::data(value), sizeof(T) * size);
+    }
+    else {
+      size_t i = 0;
+      for (const auto& element : value)
+        new (data + i++) Element(flat<T>::make(element, arena));
+    }
+    return data;
+  }
+
+  // The element type of a range, as its iterators tell it (bool rather than
+  // the proxy references of std::vector<bool>)
+  template <typename T>
+  using range_value_t = typename std::iterator_traits<decltype(std::begin(std::declval<const T&>()))>::value_type;
+
+  // Sequences (vectors, lists, deques, arrays, spans, ...), other ranges
+  // printed like them and pprint::Range, whose copies may not own their
+  // elements, are copied element by element
+  template <typename T, typename = void>
+  struct is_flat_sequence : std::false_type {};
+
+  template <typename T>
+  struct is_flat_sequence<T, std::enable_if_t<std::is_class_v<T>>>
+    : std::bool_constant<is_specialization<T, Range>::value ||
+      std::is_same_v<typename category_of<T>::type, category::sequence> ||
+      std::is_same_v<typename category_of<T>::type, category::range>> {};
+
+  // Vectors and initializer_lists are contiguous. Ranges of unknown size
+  // are counted first, or collected when they can only be walked once, and
+  // keep printing as ranges of unknown size.
+  template <typename Container>
+  struct flat<Container, std::enable_if_t<is_flat_sequence<Container>::value &&
+      has_arena_flat<range_value_t<Container>>::value>> {
+    typedef range_value_t<Container> T;
+    typedef typename flat<T>::type Element;
+    typedef typename std::iterator_traits<decltype(std::begin(std::declval<const Container&>()))>::iterator_category
+      Category;
+    static constexpr bool contiguous = (is_specialization<Container, std::vector>::value &&
+      !std::is_same_v<T, bool>) || is_specialization<Container, std::initializer_list>::value;
+    typedef FlatSequence<Element, false,
+      is_container<std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<const Container&>()))>>>::value>
+      type;
+
+    static type make(const Container& value, Arena& arena) {
+      const size_t size = printed_size(value);
+      if (size != unknown_size)
+        return type {flat_elements<Element, contiguous>(value, size, arena), size};
+      if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+        size_t count = 0;
+        for (auto it = std::begin(value), last = std::end(value); it != last; ++it)
+          count++;
+        return type {flat_elements<Element, false>(value, count, arena), count, true};
+      }
+      else {
+        std::vector<Element> elements;
+        for (const auto& element : value)
+          elements.push_back(flat<T>::make(element, arena));
+        Element * data = arena.allocate_array<Element>(elements.size());
+        std::uninitialized_copy(elements.begin(), elements.end(), data);
+        return type {data, elements.size(), true};
+      }
+    }
+
+    // The size printing passes to print_elements
+    static size_t printed_size(const Container& value) {
+      if constexpr (is_specialization<Container, Range>::value ||
+          std::is_same_v<typename category_of<Container>::type, category::sequence>)
+        return value.size();
+      else
+        return range(value).size();
+    }
+  };
+
+  // Character arrays are printed as strings, other arrays like std::array
+  template <typename T, std::size_t N>
+  struct flat<T[N], std::enable_if_t<std::is_same_v<std::remove_cv_t<T>, char>>> {
+    typedef FlatString type;
+    static FlatString make(const T (&value)[N], Arena& arena) {
+      return flat_string(value, arena);
+    }
+  };
+
+  template <typename T, std::size_t N>
+  struct flat<T[N], std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, char> &&
+      has_arena_flat<std::remove_cv_t<T>>::value>> {
+    typedef typename flat<std::remove_cv_t<T>>::type Element;
+    typedef FlatSequence<Element, false, is_container<std::remove_cv_t<T>>::value> type;
+    static type make(const T (&value)[N], Arena& arena) {
+      return type {flat_elements<Element, true>(value, N, arena), N};
+    }
+  };
+
+  inline std::string demangle(const char* name) {
+#ifdef __GNUG__
+    int status = -4;
+    std::unique_ptr<char, void(*)(void*)> res {
+      abi::__cxa_demangle(name, NULL, NULL, &status),
+      std::free
+    };
+    return (status==0) ? res.get() : name;
+#else
+    return name;
+#endif
+  }
+
+// Type names are read from __PRETTY_FUNCTION__ / __FUNCSIG__ at compile time where
+// the compiler allows it, as magic_enum does for enum names. Define
+// PPRINT_CONSTEXPR_TYPE_NAME=0 to fall back to demangling typeid names at runtime.
+#if !defined(PPRINT_CONSTEXPR_TYPE_NAME)
+#  if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9) || defined(_MSC_VER)
+#    define PPRINT_CONSTEXPR_TYPE_NAME 1
+#  else
+#    define PPRINT_CONSTEXPR_TYPE_NAME 0
+#  endif
+#endif
+
+#if PPRINT_CONSTEXPR_TYPE_NAME
+  // The name of T is spelled out inside the function signature, between a
+  // prefix and a suffix that are found once by probing with a known type
+  template <typename T>
+  constexpr std::string_view raw_type_name() noexcept {
+#if defined(_MSC_VER)
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+  }
+
+  constexpr std::size_t type_name_prefix = raw_type_name<double>().find("double");
+  constexpr std::size_t type_name_suffix = raw_type_name<double>().size() - type_name_prefix - sizeof("double") + 1;
+
+  // Name of T, computed at compile time
+  template <typename T>
+  constexpr std::string_view type_name() noexcept {
+    constexpr std::string_view raw = raw_type_name<T>();
+    std::string_view name = raw.substr(type_name_prefix, raw.size() - type_name_prefix - type_name_suffix);
+#if defined(_MSC_VER)
+    // MSVC spells out the class-key
+    for (std::string_view key : {"class ", "struct ", "union ", "enum "}) {
+      if (name.substr(0, key.size()) == key) {
+        name.remove_prefix(key.size());
+        break;
+      }
+    }
+#endif
+    return name;
+  }
+#else
+  // Name of T, demangled once per type and cached
+  template <typename T>
+  std::string_view type_name() {
+    static const std::string name = demangle(typeid(T).name());
+    return name;
+  }
+#endif
+
+  // How floating point numbers are written, see PrettyPrinter::float_format
+  enum class FloatFormat {
+    shortest,   // shortest text that reads back as the same value
+    fixed,      // 123.456
+    scientific, // 1.23456e+02
+    general     // fixed or scientific, whichever is shorter, like printf %g
+  };
+
+  // What a print writes, see PrettyPrinter::output_format
+  enum class OutputFormat {
+    text,   // for people to read
+    json,   // one JSON value per print
+    logfmt, // one line of key=value fields per print
+    binary  // one CBOR data item per print, see pprint/capture.hpp
+  };
+
+  // CBOR tags of OutputFormat::binary, for what CBOR has no type of its own
+  enum class CaptureTag : std::uint16_t {
+    text = 0x7070, // a string printed as it is (operator<<, pointers, objects)
+    character,     // a char, as a string of one byte
+    set,           // an array printed in braces
+    tuple,         // an array printed as a std::tuple
+    pair,          // an array of two printed as a std::pair
+    enumeration,   // [value, name], the name empty if there is none
+    variant,       // [index, value]
+    complex,       // [real, imaginary]
+    queue,         // an array printed on one line
+    stack,         // an array printed one element per line
+    nested,        // an array whose elements or a map whose values are containers
+    print_inline,  // a record printed by print_inline
+    pointer,       // [text, pointee], a smart pointer; the pointee null when there is none
+    float32        // a float, rather than a double
+  };
+
+  // Formatting state (flags, precision, locale) of a stream nobody has
+  // changed, followed by printers that write to strings. Those printers
+  // hand their output to a target and only read the stream; having no
+  // buffer, it would drop anything written. Each thread has its own.
+  inline std::ostream& default_format_state() {
+    thread_local std::ostream state(nullptr);
+    return state;
+  }
+
+  class PrettyPrinter;
+
+  template <typename T>
+  std::string pformat(const T& value, const PrettyPrinter& options);
+
+  template <typename OutputIt, typename T>
+  OutputIt format_to(OutputIt out, const T& value, const PrettyPrinter& options);
+
+  // Size of what a print would write, see PrettyPrinter::measure
+  struct Measurement {
+    size_t bytes;
+    size_t lines; // line breaks written
+  };
+
+  // Character types that operator<< writes as characters rather than numbers
+  template <typename T>
+  struct is_character : std::bool_constant<
+    std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+    std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>
+#if defined(__cpp_char8_t)
+    || std::is_same_v<T, char8_t>
+#endif
+  > {};
+
+  // Length of the UTF-8 encoded character value starts with, or 0 when it
+  // does not start with one (overlong encodings and surrogates included)
+  inline size_t utf8_length(std::string_view value) {
+    const auto byte = [&value](size_t i) { return static_cast<unsigned char>(value[i]); };
+    const auto continuation = [&](size_t i, unsigned char low = 0x80, unsigned char high = 0xbf) {
+      return i < value.size() && byte(i) >= low && byte(i) <= high;
+    };
+    const unsigned char lead = byte(0);
+    if (lead < 0x80)
+      return 1;
+    if (lead >= 0xc2 && lead <= 0xdf)
+      return continuation(1) ? 2 : 0;
+    if (lead >= 0xe0 && lead <= 0xef) {
+      const bool second = lead == 0xe0 ? continuation(1, 0xa0) : lead == 0xed ? continuation(1, 0x80, 0x9f) :
+        continuation(1);
+      return second && continuation(2) ? 3 : 0;
+    }
+    if (lead >= 0xf0 && lead <= 0xf4) {
+      const bool second = lead == 0xf0 ? continuation(1, 0x90) : lead == 0xf4 ? continuation(1, 0x80, 0x8f) :
+        continuation(1);
+      return second && continuation(2) && continuation(3) ? 4 : 0;
+    }
+    return 0;
+  }
+
+  // Whether value is valid UTF-8
+  inline bool valid_utf8(std::string_view value) {
+    for (size_t i = plain_prefix(value, '\x7f'); i < value.size(); i += plain_prefix(value.substr(i), '\x7f')) {
+      const size_t length = utf8_length(value.substr(i));
+      if (length == 0)
+        return false;
+      i += length;
+    }
+    return true;
+  }
+
+  // A double-ended queue in a single std::vector, whose capacity is a
+  // power of two. Clearing it frees nothing, so once it has grown to the
+  // largest size it holds it no longer allocates.
+  template <typename T>
+  class RingBuffer {
+  public:
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    T& operator[](size_t index) {
+      return items_[(head_ + index) & (items_.size() - 1)];
+    }
+
+    T& front() {
+      return (*this)[0];
+    }
+
+    T& back() {
+      return (*this)[size_ - 1];
+    }
+
+    void push_back(const T& value) {
+      if (size_ == items_.size())
+        grow();
+      (*this)[size_++] = value;
+    }
+
+    void pop_front() {
+      head_ = (head_ + 1) & (items_.size() - 1);
+      size_ -= 1;
+    }
+
+    void pop_back() {
+      size_ -= 1;
+    }
+
+    void clear() {
+      head_ = 0;
+      size_ = 0;
+    }
+
+  private:
+    void grow() {
+      std::vector<T> items(std::max<size_t>(items_.size() * 2, 64));
+      for (size_t i = 0; i < size_; i++)
+        items[i] = (*this)[i];
+      items_.swap(items);
+      head_ = 0;
+    }
+
+    std::vector<T> items_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+  };
+
+  // Oppen's linear-time pretty printing algorithm ("Prettyprinting", 1980),
+  // used by printers with a width. Text, line breaks and groups are fed in
+  // as they are printed. A group whose text fits in what is left of the
+  // line is printed on it, breaks and all, otherwise every break of the
+  // group starts a new line. Tokens are only held back until it is known
+  // whether their group fits, that is for at most a line's worth of text,
+  // so layout takes time linear in the size of the output. The tokens and
+  // held back text are kept in storage that is reused from one record to
+  // the next.
+  class Layout {
+  public:
+    // Starts a record printed in lines of width characters, with broken
+    // groups indented relative to indent
+    void start(size_t width, size_t indent) {
+      margin_ = static_cast<long>(width);
+      space_ = margin_;
+      indent_ = static_cast<long>(indent);
+      pending_indent_ = 0;
+      left_total_ = right_total_ = 0;
+      first_index_ = 0;
+      tokens_.clear();
+      scan_stack_.clear();
+      frames_.clear();
+      text_.clear();
+      consumed_ = 0;
+    }
+
+    // Opens a group whose lines are indented by offset more than the
+    // lines of the enclosing group
+    void begin(long offset) {
+      if (scan_stack_.empty())
+        reset();
+      scan_stack_.push_back(push(Token {Kind::begin, -right_total_, 0, offset}));
+    }
+
+    void end() {
+      if (scan_stack_.empty())
+        print_end();
+      else
+        scan_stack_.push_back(push(Token {Kind::end, -1, 0, 0}));
+    }
+
+    // A break: blank spaces when its group fits on the line, otherwise a
+    // new line indented by the group's indent plus offset
+    void line_break(size_t blank, long offset) {
+      if (scan_stack_.empty())
+        reset();
+      else
+        check_stack(0);
+      scan_stack_.push_back(push(Token {Kind::line_break, -right_total_, blank, offset}));
+      right_total_ += static_cast<long>(blank);
+    }
+
+    void text(std::string_view value, std::string& out) {
+      if (scan_stack_.empty()) {
+        print_text(value, out);
+        return;
+      }
+      text_.append(value.data(), value.size());
+      push(Token {Kind::text, static_cast<long>(value.size()), value.size(), 0});
+      right_total_ += static_cast<long>(value.size());
+      check_stream(out);
+    }
+
+    // Prints whatever is still held back
+    void finish(std::string& out) {
+      if (!scan_stack_.empty()) {
+        check_stack(0);
+        advance_left(out);
+      }
+    }
+
+  private:
+    enum class Kind { text, begin, end, line_break };
+
+    struct Token {
+      Kind kind;
+      long size;     // length up to the next break, negative while unknown
+      size_t length; // of text, or blank spaces of a break
+      long offset;
+    };
+
+    // A group being printed: the indent to restore at its end and whether
+    // its breaks start new lines
+    struct Frame {
+      long indent;
+      bool broken;
+    };
+
+    static constexpr long infinity = std::numeric_limits<long>::max() / 2;
+
+    void reset() {
+      left_total_ = right_total_ = 1;
+      first_index_ += tokens_.size();
+      tokens_.clear();
+    }
+
+    size_t push(const Token& token) {
+      tokens_.push_back(token);
+      return first_index_ + tokens_.size() - 1;
+    }
+
+    Token& token(size_t index) {
+      return tokens_[index - first_index_];
+    }
+
+    // Prints tokens from the left while their size is known
+    void advance_left(std::string& out) {
+      while (!tokens_.empty() && tokens_.front().size >= 0) {
+        const Token left = tokens_.front();
+        tokens_.pop_front();
+        first_index_ += 1;
+        switch (left.kind) {
+        case Kind::text:
+          left_total_ += static_cast<long>(left.length);
+          print_text(std::string_view(text_).substr(consumed_, left.length), out);
+          consumed_ += left.length;
+          break;
+        case Kind::line_break:
+          left_total_ += static_cast<long>(left.length);
+          print_break(left, out);
+          break;
+        case Kind::begin:
+          print_begin(left);
+          break;
+        case Kind::end:
+          print_end();
+          break;
+        }
+      }
+      // Held back text is dropped once printed
+      if (tokens_.empty() || consumed_ > (1 << 16)) {
+        text_.erase(0, consumed_);
+        consumed_ = 0;
+      }
+    }
+
+    // Prints tokens that cannot fit on the line anyway
+    void check_stream(std::string& out) {
+      while (right_total_ - left_total_ > space_ && !tokens_.empty()) {
+        if (!scan_stack_.empty() && scan_stack_.front() == first_index_) {
+          scan_stack_.pop_front();
+          tokens_.front().size = infinity;
+        }
+        advance_left(out);
+      }
+    }
+
+    // Sets the sizes of the groups and breaks closed by the latest break
+    void check_stack(size_t depth) {
+      while (!scan_stack_.empty()) {
+        Token& entry = token(scan_stack_.back());
+        if (entry.kind == Kind::begin) {
+          if (depth == 0)
+            break;
+          scan_stack_.pop_back();
+          entry.size += right_total_;
+          depth -= 1;
+        }
+        else if (entry.kind == Kind::end) {
+          scan_stack_.pop_back();
+          entry.size = 1;
+          depth += 1;
+        }
+        else {
+          scan_stack_.pop_back();
+          entry.size += right_total_;
+          if (depth == 0)
+            break;
+        }
+      }
+    }
+
+    void print_begin(const Token& begin) {
+      if (begin.size > space_) {
+        frames_.push_back(Frame {indent_, true});
+        indent_ += begin.offset;
+      }
+      else {
+        frames_.push_back(Frame {indent_, false});
+      }
+    }
+
+    void print_end() {
+      if (frames_.empty())
+        return;
+      indent_ = frames_.back().indent;
+      frames_.pop_back();
+    }
+
+    void print_break(const Token& line_break, std::string& out) {
+      if (frames_.empty() || !frames_.back().broken) {
+        pending_indent_ += line_break.length;
+        space_ -= static_cast<long>(line_break.length);
+      }
+      else {
+        // The blanks end the line, as they do when printing without a width
+        out.append(line_break.length, ' ');
+        out.push_back('\n');
+        const long indent = std::max(indent_ + line_break.offset, 0L);
+        pending_indent_ = static_cast<size_t>(indent);
+        space_ = margin_ - indent;
+      }
+    }
+
+    void print_text(std::string_view value, std::string& out) {
+      out.append(pending_indent_, ' ');
+      pending_indent_ = 0;
+      out.append(value.data(), value.size());
+      // Text can end lines of its own
+      const size_t newline = value.rfind('\n');
+      if (newline == std::string_view::npos)
+        space_ -= static_cast<long>(value.size());
+      else
+        space_ = margin_ - static_cast<long>(value.size() - newline - 1);
+    }
+
+    long margin_ = 0;
+    long space_ = 0;
+    long indent_ = 0;
+    size_t pending_indent_ = 0;
+    long left_total_ = 0;
+    long right_total_ = 0;
+    size_t first_index_ = 0;
+    RingBuffer<Token> tokens_;
+    RingBuffer<size_t> scan_stack_;
+    std::vector<Frame> frames_;
+    std::string text_;
+    size_t consumed_ = 0;
+  };
+
+  class PrettyPrinter {
+  private:
+    std::ostream& stream_;
+    AsyncSink * sink_;
+    std::string line_terminator_;
+    size_t indent_;
+    bool quotes_;
+    bool compact_;
+    bool heap_order_;
+    bool thread_safe_;
+    bool parallel_;
+    size_t parallel_threshold_;
+    size_t width_;
+    FloatFormat float_format_;
+    int precision_;
+    OutputFormat format_;
+    size_t max_items_;
+    size_t max_depth_;
+    size_t max_string_length_;
+    size_t flush_threshold_;
+
+    // Output is rendered into buffer_ and handed to stream_ in large blocks,
+    // whenever flush_threshold_ is reached and at the end of every print
+    std::string buffer_;
+
+    // Values that only know how to print themselves through operator<<
+    // (numbers, user types, tuples) are formatted by format_stream_, which
+    // appends to buffer_ using the formatting state of stream_
+    struct FormatStream {
+      StringBuffer buffer;
+      std::ostream stream;
+      explicit FormatStream(std::string& target) : buffer(target), stream(&buffer) {}
+    };
+    std::unique_ptr<FormatStream> format_stream_;
+    bool format_state_synced_;
+
+    // Text formatted by format_stream_ for the layout engine
+    std::string formatted_;
+
+    // Buffers, format stream and layout engine kept per thread for the
+    // copies of a printer that thread_safe printing and measure use
+    struct Scratch {
+      std::string buffer;
+      std::string formatted;
+      std::unique_ptr<FormatStream> format_stream;
+      std::unique_ptr<Layout> layout;
+    };
+
+    // The scratch space of this thread, shared by every printer and record
+    static Scratch& thread_scratch() {
+      thread_local Scratch scratch;
+      return scratch;
+    }
+
+    // Lends the scratch space of this thread to printer, a fresh copy, for
+    // as long as it lives, and takes it back however the printing returns.
+    // A loan made while another is out finds the scratch empty and sets up
+    // its own.
+    struct ScratchLoan {
+      PrettyPrinter& printer;
+      Scratch& scratch;
+
+      explicit ScratchLoan(PrettyPrinter& printer) : printer(printer), scratch(thread_scratch()) {
+        printer.buffer_.swap(scratch.buffer);
+        printer.formatted_.swap(scratch.formatted);
+        printer.format_stream_ = std::move(scratch.format_stream);
+        if (printer.format_stream_)
+          printer.format_stream_->buffer.target(printer.buffer_);
+        printer.layout_engine_ = std::move(scratch.layout);
+      }
+
+      ~ScratchLoan() {
+        printer.buffer_.clear();
+        printer.buffer_.swap(scratch.buffer);
+        printer.formatted_.swap(scratch.formatted);
+        scratch.format_stream = std::move(printer.format_stream_);
+        scratch.layout = std::move(printer.layout_engine_);
+      }
+
+      ScratchLoan(const ScratchLoan&) = delete;
+      ScratchLoan& operator=(const ScratchLoan&) = delete;
+    };
+
+    // Whether stream_ still has default number formatting, checked once per print
+    bool stream_state_checked_;
+    bool plain_stream_;
+
+    // Lays out the record being printed when width_ is set; everything
+    // written goes through it
+    std::unique_ptr<Layout> layout_engine_;
+    Layout * layout_ = nullptr;
+
+    // Set while measuring: output is counted here instead of written
+    Measurement * measurement_ = nullptr;
+
+    // Takes the output instead of stream_ when set (see pformat), leaving
+    // the buffer it is given empty
+    void (*target_)(void *, std::string&) = nullptr;
+    void * target_context_ = nullptr;
+
+    // A deferred print: a copy of its arguments in arena_ and how to render
+    // and destroy it. Records form a list in the order they were printed.
+    struct Capture {
+      void (*render)(PrettyPrinter&, const void *);
+      void (*destroy)(void *);
+      void * values;
+      Capture * next;
+    };
+    bool deferred_;
+    Arena arena_;
+    Capture * first_capture_;
+    Capture * last_capture_;
+
+    PrettyPrinter(std::ostream& stream, AsyncSink * sink) :
+      stream_(stream),
+      sink_(sink),
+      line_terminator_("\n"),
+      indent_(2),
+      quotes_(false),
+      compact_(false),
+      heap_order_(false),
+      thread_safe_(false),
+      parallel_(false),
+      parallel_threshold_(1 << 16),
+      width_(0),
+      float_format_(FloatFormat::shortest),
+      precision_(-1),
+      format_(OutputFormat::text),
+      max_items_(std::numeric_limits<size_t>::max()),
+      max_depth_(std::numeric_limits<size_t>::max()),
+      max_string_length_(std::numeric_limits<size_t>::max()),
+      flush_threshold_(1 << 16),
+      format_state_synced_(false),
+      stream_state_checked_(false),
+      plain_stream_(true),
+      deferred_(false),
+      first_capture_(nullptr),
+      last_capture_(nullptr) {}
+
+    // Copies the settings of other, printing to stream or sink
+    PrettyPrinter(const PrettyPrinter& other, std::ostream& stream, AsyncSink * sink) :
+      stream_(stream),
+      sink_(sink),
+      line_terminator_(other.line_terminator_),
+      indent_(other.indent_),
+      quotes_(other.quotes_),
+      compact_(other.compact_),
+      heap_order_(other.heap_order_),
+      thread_safe_(other.thread_safe_),
+      parallel_(other.parallel_),
+      parallel_threshold_(other.parallel_threshold_),
+      width_(other.width_),
+      float_format_(other.float_format_),
+      precision_(other.precision_),
+      format_(other.format_),
+      max_items_(other.max_items_),
+      max_depth_(other.max_depth_),
+      max_string_length_(other.max_string_length_),
+      flush_threshold_(other.flush_threshold_),
+      format_state_synced_(false),
+      stream_state_checked_(false),
+      plain_stream_(true),
+      deferred_(other.deferred_),
+      first_capture_(nullptr),
+      last_capture_(nullptr) {}
+
+    // Copies the settings of other, handing the output to target(context,
+    // buffer) instead of a stream. Formatting follows the defaults of a
+    // stream rather than std::cout's, and every print is rendered right away.
+    PrettyPrinter(const PrettyPrinter& other, void (*target)(void *, std::string&), void * context) :
+      PrettyPrinter(other, default_format_state(), nullptr) {
+      thread_safe_ = false;
+      deferred_ = false;
+      target_ = target;
+      target_context_ = context;
+    }
+
+    template <typename T>
+    friend std::string pformat(const T& value, const PrettyPrinter& options);
+
+    template <typename OutputIt, typename T>
+    friend OutputIt format_to(OutputIt out, const T& value, const PrettyPrinter& options);
+
+    template <typename Category>
+    friend struct category_printer;
+
+  public:
+
+    PrettyPrinter(std::ostream& stream = std::cout) :
+      PrettyPrinter(stream, nullptr) {}
+
+    // Prints through a background thread, see AsyncSink. Every print is
+    // pushed to the sink as one record.
+    explicit PrettyPrinter(AsyncSink& sink) :
+      PrettyPrinter(sink.format_state(), &sink) {}
+
+    // Copies the settings, not the pending output
+    PrettyPrinter(const PrettyPrinter& other) :
+      PrettyPrinter(other, other.stream_, other.sink_) {
+      target_ = other.target_;
+      target_context_ = other.target_context_;
+    }
+
+    // Takes over the settings, the pending output and the deferred records
+    PrettyPrinter(PrettyPrinter&& other) :
+      PrettyPrinter(static_cast<const PrettyPrinter&>(other)) {
+      buffer_.swap(other.buffer_);
+      std::swap(arena_, other.arena_);
+      std::swap(first_capture_, other.first_capture_);
+      std::swap(last_capture_, other.last_capture_);
+    }
+
+    ~PrettyPrinter() {
+      flush();
+    }
+
+    PrettyPrinter& line_terminator(std::string_view value) {
+      line_terminator_ = value;
+      return *this;
+    }
+
+    PrettyPrinter& indent(size_t indent) {
+      indent_ = indent;
+      return *this;
+    }
+
+    PrettyPrinter& compact(bool value) {
+      compact_ = value;
+      return *this;
+    }
+
+    PrettyPrinter& quotes(bool value) {
+      quotes_ = value;
+      return *this;
+    }
+
+    // Print priority queues in the order of their underlying heap rather
+    // than in pop order
+    PrettyPrinter& heap_order(bool value) {
+      heap_order_ = value;
+      return *this;
+    }
+
+    // Let several threads print through this printer, or through printers
+    // sharing its stream. Every print then renders into a thread-local
+    // buffer and reaches the stream in a single write, under a lock held by
+    // all thread-safe printers of that stream (or is pushed to the sink as
+    // one record); flush_threshold is ignored.
+    // Settings must not be changed while other threads are printing.
+    PrettyPrinter& thread_safe(bool value) {
+      thread_safe_ = value;
+      return *this;
+    }
+
+    // Lay containers out in lines of at most this many characters, where
+    // possible: a container is printed on one line if it fits in what is
+    // left of the line, and with one element per line otherwise, each
+    // nested container deciding for itself. compact is ignored. 0, the
+    // default, turns this off.
+    PrettyPrinter& width(size_t value) {
+      width_ = value;
+      return *this;
+    }
+
+    // Format containers with at least parallel_threshold elements to print
+    // on the shared ThreadPool, in chunks that are written in order, so
+    // the output is the same. Elements must be safe to print concurrently.
+    PrettyPrinter& parallel(bool value) {
+      parallel_ = value;
+      return *this;
+    }
+
+    PrettyPrinter& parallel_threshold(size_t elements) {
+      parallel_threshold_ = elements;
+      return *this;
+    }
+
+    // Floating point notation. The default, FloatFormat::shortest, writes the
+    // shortest text that reads back as exactly the same value.
+    PrettyPrinter& float_format(FloatFormat value) {
+      float_format_ = value;
+      return *this;
+    }
+
+    // Digits after the decimal point (fixed, scientific) or significant digits
+    // (general, shortest). A negative value restores the default.
+    PrettyPrinter& precision(int value) {
+      precision_ = value;
+      return *this;
+    }
+
+    // Write every print as a JSON value (OutputFormat::json) or as a line of
+    // logfmt fields (OutputFormat::logfmt) instead of text. Machine-readable
+    // output is complete and on one line: width, indent, compact, quotes and
+    // the max_ limits only apply to text. In JSON, sequences, sets, tuples,
+    // pairs and adaptors are arrays; maps are objects, with keys that are
+    // not strings written as strings of their JSON; complex numbers are
+    // {"real":r,"imag":i}; enums are their name, or their value if they
+    // have none; optionals and variants are what they hold, nullopt and
+    // null pointers null; NaN and infinities null too. Anything else
+    // (operator<<, pointers, objects) is its text as a string. Several
+    // arguments make an array.
+    // In logfmt, the entries of a map argument are fields, nested maps with
+    // dotted keys, a pair argument is one field and any other argument is
+    // the field argN. Text, numbers and enums are field values as they are,
+    // anything else is its JSON; keys and values are quoted and escaped
+    // when they are empty or contain spaces, quotes, '=' or other than
+    // printable ASCII.
+    // OutputFormat::binary captures every print as a CBOR array of its
+    // arguments, with the CaptureTags needed to print it again later:
+    // pprint::render (pprint/capture.hpp) and the pprint-render tool print
+    // captures as text, JSON or logfmt with the settings they are given.
+    // Numbers are captured as binary integers and floats; chars as strings.
+    PrettyPrinter& output_format(OutputFormat value) {
+      format_ = value;
+      return *this;
+    }
+
+    // Print at most this many elements of each container, followed by
+    // "... N more". Elements past the limit are never visited.
+    PrettyPrinter& max_items(size_t value) {
+      max_items_ = value;
+      return *this;
+    }
+
+    // Print containers nested deeper than this as "[...]"; 0 elides even
+    // the outermost container
+    PrettyPrinter& max_depth(size_t value) {
+      max_depth_ = value;
+      return *this;
+    }
+
+    // Cut strings longer than this and end them with "..."
+    PrettyPrinter& max_string_length(size_t value) {
+      max_string_length_ = value;
+      return *this;
+    }
+
+    // Keep a copy of what is printed instead of formatting it: strings and
+    // containers are copied flat into an arena that is reused, anything
+    // else is copy constructed (and what cannot be copied is printed right
+    // away). The records are formatted by flush(), or on another thread
+    // after detach(), with the settings in effect then.
+    // Deferred printing is not thread_safe.
+    PrettyPrinter& deferred(bool value) {
+      deferred_ = value;
+      if (value)
+        arena_.reserve();
+      return *this;
+    }
+
+    // Moves the deferred records to a new printer with the same settings
+    // (not deferred), e.g., to format them on a background thread by
+    // flushing or destroying it there
+    PrettyPrinter detach() {
+      PrettyPrinter records(*this);
+      records.deferred_ = false;
+      std::swap(records.arena_, arena_);
+      std::swap(records.first_capture_, first_capture_);
+      std::swap(records.last_capture_, last_capture_);
+      if (deferred_)
+        arena_.reserve();
+      return records;
+    }
+
+    // Number of buffered bytes after which output is handed to the stream
+    // in the middle of a print
+    PrettyPrinter& flush_threshold(size_t bytes) {
+      flush_threshold_ = bytes;
+      return *this;
+    }
+
+    template <typename T>
+    void print(const T& value) {
+      if (deferred_ && capture<false>(value))
+        return;
+      record([&](PrettyPrinter& printer) { printer.print_arguments(0, printer.line_terminator_, value); });
+    }
+
+    template <typename T>
+    void print(std::initializer_list<T> value) {
+      if (deferred_ && capture<false>(value))
+        return;
+      record([&](PrettyPrinter& printer) { printer.print_arguments(0, printer.line_terminator_, value); });
+    }
+
+    template<typename T, typename... Targs>
+    void print(const T& value, const Targs&... Fargs) {
+      if (deferred_ && capture<false>(value, Fargs...))
+        return;
+      record([&](PrettyPrinter& printer) { printer.print_arguments(0, printer.line_terminator_, value, Fargs...); });
+    }
+
+    template <typename T>
+    void print_inline(const T& value) {
+      if (deferred_ && capture<true>(value))
+        return;
+      record([&](PrettyPrinter& printer) { printer.print_arguments(printer.indent_, "", value); });
+    }
+
+    template <typename T>
+    void print_inline(std::initializer_list<T> value) {
+      if (deferred_ && capture<true>(value))
+        return;
+      record([&](PrettyPrinter& printer) { printer.print_arguments(printer.indent_, "", value); });
+    }
+
+    template<typename T, typename... Targs>
+    void print_inline(const T& value, const Targs&... Fargs) {
+      if (deferred_ && capture<true>(value, Fargs...))
+        return;
+      record([&](PrettyPrinter& printer) { printer.print_arguments(printer.indent_, "", value, Fargs...); });
+    }
+
+    // Number of bytes and lines print(values...) would write with the
+    // current settings. Nothing is written or kept: the values are
+    // traversed as for printing, integers are measured by counting their
+    // digits and text is counted where it would be copied. The counting is
+    // done by a copy of the printer using this thread's scratch space, so
+    // measuring allocates nothing once a value as large has been measured.
+    template <typename T, typename... Targs>
+    Measurement measure(const T& value, const Targs&... values) const {
+      Measurement result {0, 0};
+      PrettyPrinter counter(*this);
+      ScratchLoan loan(counter);
+      counter.measurement_ = &result;
+      counter.parallel_ = false;
+      counter.flush_threshold_ = std::numeric_limits<size_t>::max();
+      counter.print_arguments(0, counter.line_terminator_, value, values...);
+      counter.count_buffer();
+      return result;
+    }
+
+    template <typename T>
+    Measurement measure(std::initializer_list<T> value) const {
+      return measure<std::initializer_list<T>>(value);
+    }
+
+    // Formats the deferred records, then hands any buffered output to the stream
+    void flush() {
+      if (first_capture_)
+        render_captures();
+      if (!buffer_.empty()) {
+        if (sink_)
+          sink_->push(buffer_);
+        else if (target_)
+          target_(target_context_, buffer_);
+        else
+          stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+      }
+      format_state_synced_ = false;
+      stream_state_checked_ = false;
+    }
+
+  private:
+
+    // Renders one record with print(printer) and hands it to the stream.
+    // Thread-safe printers are never written to: the record is rendered by
+    // a copy of the printer into this thread's scratch buffer.
+    template <typename F>
+    void record(F&& print) {
+      if (!thread_safe_) {
+        print(*this);
+        flush();
+        return;
+      }
+      PrettyPrinter printer(*this);
+      printer.flush_threshold_ = std::numeric_limits<size_t>::max();
+      ScratchLoan loan(printer);
+      print(printer);
+      if (sink_) {
+        sink_->push(printer.buffer_);
+        return;
+      }
+      std::lock_guard<std::mutex> lock(stream_mutex(stream_));
+      stream_.write(printer.buffer_.data(), static_cast<std::streamsize>(printer.buffer_.size()));
+    }
+
+    // Deferred printing: copies the arguments into arena_ and appends a
+    // record that prints them at flush(). Arguments that cannot be copied
+    // are printed right away instead, after the records before them; the
+    // copying code is only instantiated for arguments that can be.
+    template <bool Inline, typename... Args>
+    bool capture(const Args&... values) {
+      if constexpr (!(is_deferrable<Args>::value && ...)) {
+        static_assert(!PPRINT_STRICT_DEFERRED || (is_deferrable<Args>::value && ...),
+          "pprint: printing a value that deferred printing cannot copy (see pprint::is_deferrable) "
+          "with PPRINT_STRICT_DEFERRED defined");
+        flush();
+        return false;
+      }
+      else {
+        capture_values<Inline>(values...);
+        return true;
+      }
+    }
+
+    template <bool Inline, typename... Args>
+    void capture_values(const Args&... values) {
+      typedef std::tuple<typename deferred<Args>::type...> Values;
+      void * memory = arena_.allocate(sizeof(Values), alignof(Values));
+      new (memory) Values(defer_value(values, arena_)...);
+      Capture * capture = static_cast<Capture*>(arena_.allocate(sizeof(Capture), alignof(Capture)));
+      *capture = Capture {&render_capture<Inline, Values>,
+        std::is_trivially_destructible_v<Values> ? nullptr : &destroy_capture<Values>, memory, nullptr};
+      if (last_capture_)
+        last_capture_->next = capture;
+      else
+        first_capture_ = capture;
+      last_capture_ = capture;
+    }
+
+    template <bool Inline, typename Values>
+    static void render_capture(PrettyPrinter& printer, const void * values) {
+      std::apply([&printer](const auto&... value) {
+        if constexpr (Inline)
+          printer.print_arguments(printer.indent_, "", value...);
+        else
+          printer.print_arguments(0, printer.line_terminator_, value...);
+      }, *static_cast<const Values*>(values));
+    }
+
+    template <typename Values>
+    static void destroy_capture(void * values) {
+      static_cast<Values*>(values)->~Values();
+    }
+
+    // Formats every deferred record into buffer_, handing each one to the
+    // sink as a record of its own
+    void render_captures() {
+      Capture * capture = first_capture_;
+      first_capture_ = last_capture_ = nullptr;
+      try {
+        for (; capture; capture = capture->next) {
+          capture->render(*this, capture->values);
+          if (sink_ && !buffer_.empty()) {
+            sink_->push(buffer_);
+            buffer_.clear();
+          }
+          if (capture->destroy)
+            capture->destroy(capture->values);
+        }
+      }
+      catch (...) {
+        for (; capture; capture = capture->next) {
+          if (capture->destroy)
+            capture->destroy(capture->values);
+        }
+        arena_.reset();
+        throw;
+      }
+      arena_.reset();
+    }
+
+    // Prints values separated by spaces, the last one followed by
+    // line_terminator, through the layout engine when a width is set
+    template <typename... Args>
+    void print_arguments(size_t indent, std::string_view line_terminator, const Args&... values) {
+      print_argument_list(indent, line_terminator, sizeof...(values), [&](auto&& print_one) {
+        size_t index = 0;
+        (print_one(values, index++), ...);
+      });
+    }
+
+    // print_arguments for count values, which for_each(print_one) passes to
+    // print_one(value, index) in order. Records read back from a capture
+    // only know their number of values at run time.
+    template <typename ForEach>
+    void print_argument_list(size_t indent, std::string_view line_terminator, size_t count, ForEach&& for_each) {
+      if (format_ == OutputFormat::binary) {
+        // An array of the values; print_inline records are tagged
+        if (line_terminator.empty())
+          write_tag(CaptureTag::print_inline);
+        begin_array(count);
+        for_each([&](const auto& value, size_t) { print_value(value, 0, ""); });
+        return;
+      }
+      if (format_ != OutputFormat::text) {
+        print_record(line_terminator, count, for_each);
+        return;
+      }
+      auto print_values = [&] {
+        for_each([&](const auto& value, size_t index) {
+          if (index + 1 == count) {
+            print_value(value, indent, line_terminator);
+          }
+          else {
+            print_value(value, indent, "");
+            write(' ');
+          }
+        });
+      };
+      if (width_ == 0) {
+        print_values();
+        return;
+      }
+      if (!layout_engine_)
+        layout_engine_ = std::make_unique<Layout>();
+      layout_engine_->start(width_, indent);
+      layout_ = layout_engine_.get();
+      struct Finish {
+        PrettyPrinter& printer;
+        ~Finish() {
+          printer.layout_ = nullptr;
+        }
+      } finish {*this};
+      print_values();
+      layout_->finish(buffer_);
+    }
+
+    // Prints one argument of a print. Defined out of line, and so not
+    // inline, for pprint_static to instantiate once for common types
+    template <typename T>
+    void print_value(const T& value, size_t indent, std::string_view line_terminator);
+
+    // Prints the count values of for_each as one record of output_format,
+    // followed by line_terminator: a JSON value (an array of them for
+    // several values) or a line of logfmt fields
+    template <typename ForEach>
+    void print_record(std::string_view line_terminator, size_t count, ForEach& for_each) {
+      if (format_ == OutputFormat::logfmt) {
+        bool first = true;
+        for_each([&](const auto& value, size_t index) { print_fields(value, index, first); });
+      }
+      else if (count == 1) {
+        for_each([&](const auto& value, size_t) { print_value(value, 0, ""); });
+      }
+      else {
+        write('[');
+        for_each([&](const auto& value, size_t index) {
+          separate(index);
+          print_value(value, 0, "");
+        });
+        write(']');
+      }
+      write(line_terminator);
+    }
+
+    // logfmt fields of the index-th value of a print: the entries of a map,
+    // a pair as one field, anything else as argN
+    template <typename T>
+    void print_fields(const T& value, size_t index, bool& first) {
+      if constexpr (is_map<T>::value) {
+        if (holds_map(value)) {
+          for (const auto& entry : value)
+            print_field(field_key("", entry_key(entry)), entry_value(entry), first);
+          return;
+        }
+      }
+      if constexpr (is_entry<T>::value) {
+        if (holds_entry(value)) {
+          print_field(field_key("", entry_key(value)), entry_value(value), first);
+          return;
+        }
+      }
+      print_field("arg" + std::to_string(index), value, first);
+    }
+
+    // key=value, or a field for each entry when value is a map that has some
+    template <typename T>
+    void print_field(const std::string& key, const T& value, bool& first) {
+      if constexpr (is_map<T>::value) {
+        if (holds_map(value) && std::begin(value) != std::end(value)) {
+          for (const auto& entry : value)
+            print_field(field_key(key, entry_key(entry)), entry_value(entry), first);
+          return;
+        }
+      }
+      if (!first)
+        write(' ');
+      first = false;
+      write_logfmt_text(key);
+      write('=');
+      std::string text;
+      render_to(text, [&] { print_internal(value, 0, "", 0); });
+      write_logfmt_text(text);
+    }
+
+    // A key or value of logfmt, quoted and escaped unless it is plain, so
+    // that distinct keys stay distinct
+    void write_logfmt_text(std::string_view text) {
+      if (!text.empty() && std::all_of(text.begin(), text.end(), logfmt_plain)) {
+        write(text);
+      }
+      else {
+        write('"');
+        write_escaped(text, '"');
+        write('"');
+      }
+    }
+
+    // Key of a field for an entry of a map, below the field prefix
+    template <typename Key>
+    std::string field_key(const std::string& prefix, const Key& key) {
+      std::string text;
+      render_to(text, [&] { print_internal(key, 0, "", 0); });
+      return prefix.empty() ? text : prefix + "." + text;
+    }
+
+    // Characters that keys and unquoted values of logfmt are made of
+    static bool logfmt_plain(char c) {
+      return c > ' ' && c < 0x7f && c != '"' && c != '=' && c != '\\';
+    }
+
+    // Prints with print() into text instead of the output: buffer_ is
+    // swapped with text, so everything is written as usual
+    template <typename F>
+    void render_to(std::string& text, F&& print) {
+      struct Restore {
+        PrettyPrinter& printer;
+        std::string& text;
+        Measurement * measurement;
+        size_t flush_threshold;
+        ~Restore() {
+          printer.buffer_.swap(text);
+          printer.measurement_ = measurement;
+          printer.flush_threshold_ = flush_threshold;
+        }
+      } restore {*this, text, measurement_, flush_threshold_};
+      buffer_.swap(text);
+      measurement_ = nullptr;
+      flush_threshold_ = std::numeric_limits<size_t>::max();
+      print();
+    }
+
+    // Groups and breaks of the layout engine, see Layout
+    void begin_group(size_t offset) {
+      layout_->begin(static_cast<long>(offset));
+    }
+
+    void end_group() {
+      layout_->end();
+    }
+
+    void line_break(size_t blank, long offset) {
+      layout_->line_break(blank, offset);
+    }
+
+    void write(std::string_view value) {
+      if (layout_ || measurement_)
+        return write_diverted(value);
+      buffer_.append(value.data(), value.size());
+      if (buffer_.size() >= flush_threshold_)
+        flush_block();
+    }
+
+    void write(char value) {
+      if (layout_ || measurement_)
+        return write_diverted(std::string_view(&value, 1));
+      buffer_.push_back(value);
+      if (buffer_.size() >= flush_threshold_)
+        flush_block();
+    }
+
+    // Indentation goes straight into the buffer, no temporary strings
+    void write_indent(size_t indent) {
+      if (indent == 0)
+        return;
+      if (layout_) {
+        static constexpr char spaces[] = "                                                                ";
+        for (size_t run; indent > 0; indent -= run) {
+          run = std::min(indent, sizeof(spaces) - 1);
+          write_diverted(std::string_view(spaces, run));
+        }
+        return;
+      }
+      if (measurement_) {
+        measurement_->bytes += indent;
+        return;
+      }
+      buffer_.append(indent, ' ');
+      if (buffer_.size() >= flush_threshold_)
+        flush_block();
+    }
+
+    // Text of a record being laid out goes to the layout engine, text of
+    // one being measured is only counted
+    void write_diverted(std::string_view value) {
+      if (layout_) {
+        layout_->text(value, buffer_);
+        if (measurement_)
+          count_buffer();
+        else if (buffer_.size() >= flush_threshold_)
+          flush_block();
+      }
+      else {
+        count(value);
+      }
+    }
+
+    void count(std::string_view value) {
+      measurement_->bytes += value.size();
+      measurement_->lines += static_cast<size_t>(std::count(value.begin(), value.end(), '\n'));
+    }
+
+    // Counts what the layout engine wrote to the buffer while measuring
+    void count_buffer() {
+      if (!measurement_)
+        return;
+      count(buffer_);
+      buffer_.clear();
+    }
+
+    // Formats value with operator<<, honouring the flags, precision and
+    // locale of the target stream
+    template <typename T>
+    void write_formatted(const T& value) {
+      if (!format_stream_)
+        format_stream_ = std::make_unique<FormatStream>(buffer_);
+      std::ostream& stream = format_stream_->stream;
+      if (!format_state_synced_) {
+        stream.flags(stream_.flags());
+        stream.precision(stream_.precision());
+        stream.fill(stream_.fill());
+        if (stream.getloc() != stream_.getloc())
+          stream.imbue(stream_.getloc());
+        format_state_synced_ = true;
+      }
+      if (layout_) {
+        // The text goes to the layout engine, so it is formatted aside
+        formatted_.clear();
+        {
+          struct Retarget {
+            StringBuffer& buffer;
+            std::string& target;
+            ~Retarget() {
+              buffer.target(target);
+            }
+          } retarget {format_stream_->buffer, buffer_};
+          format_stream_->buffer.target(formatted_);
+          stream << value;
+        }
+        write_diverted(formatted_);
+        return;
+      }
+      const size_t start = buffer_.size();
+      stream << value;
+      if (measurement_) {
+        count(std::string_view(buffer_).substr(start));
+        buffer_.resize(start);
+      }
+      if (buffer_.size() >= flush_threshold_)
+        flush_block();
+    }
+
+    // Numbers are written with std::to_chars straight into the buffer. When
+    // the printer has no float_format/precision of its own and the stream's
+    // formatting has been changed (std::hex, std::setprecision, a locale...),
+    // the stream's formatting is used instead.
+    template <typename T>
+    void write_number(T value) {
+      if (format_ == OutputFormat::binary)
+        return write_binary_number(value);
+      if constexpr (std::is_floating_point_v<T>) {
+        if (float_format_ == FloatFormat::shortest && precision_ < 0 && !plain_stream())
+          return write_formatted(value);
+      }
+      else if (!plain_stream()) {
+        return write_formatted(value);
+      }
+      else if (measurement_ && !layout_) {
+        measurement_->bytes += decimal_digits(value);
+        return;
+      }
+      char digits[128];
+      auto result = to_chars(digits, digits + sizeof(digits), value);
+      if (result.ec == std::errc()) {
+        write(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+        return;
+      }
+      // Only fixed notation of very large values needs more room
+      std::string large(static_cast<size_t>(std::numeric_limits<T>::max_exponent10) +
+        static_cast<size_t>(std::max(precision_, 0)) + 16, '\0');
+      result = to_chars(&large[0], &large[0] + large.size(), value);
+      write(std::string_view(large.data(), static_cast<size_t>(result.ptr - large.data())));
+    }
+
+    // CBOR integers, and floats and doubles in the shortest of half, single
+    // and double precision that holds them exactly (long doubles as
+    // doubles). Floats are tagged, to be read back as floats.
+    template <typename T>
+    void write_binary_number(T value) {
+      if constexpr (std::is_integral_v<T>) {
+        if constexpr (std::is_signed_v<T>) {
+          if (value < 0)
+            return write_head(1, static_cast<std::uint64_t>(-(static_cast<std::int64_t>(value) + 1)));
+        }
+        write_head(0, static_cast<std::uint64_t>(value));
+      }
+      else {
+        if constexpr (std::is_same_v<T, float>)
+          write_tag(CaptureTag::float32);
+        const double real = static_cast<double>(value);
+        std::uint64_t bits;
+        std::memcpy(&bits, &real, sizeof(bits));
+        std::uint64_t shorter;
+        if (half_precision(bits, shorter))
+          write_float_bits('\xf9', shorter, 2);
+        else if (single_precision(bits, shorter))
+          write_float_bits('\xfa', shorter, 4);
+        else
+          write_float_bits('\xfb', bits, 8);
+      }
+    }
+
+    void write_float_bits(char initial, std::uint64_t bits, size_t size) {
+      char bytes[9] = {initial};
+      for (size_t i = size; i > 0; i--, bits >>= 8)
+        bytes[i] = static_cast<char>(bits & 0xff);
+      write(std::string_view(bytes, size + 1));
+    }
+
+    // The bits of the half precision number equal to the double with the
+    // given bits, if there is one. NaNs keep their sign only.
+    static bool half_precision(std::uint64_t bits, std::uint64_t& half) {
+      const std::uint64_t sign = bits >> 63 << 15;
+      const int exponent = static_cast<int>(bits >> 52 & 0x7ff) - 1023;
+      const std::uint64_t mantissa = bits & ((std::uint64_t(1) << 52) - 1);
+      if (exponent == 1024)
+        half = sign | (mantissa ? 0x7e00 : 0x7c00);
+      else if (exponent == -1023 && mantissa == 0)
+        half = sign;
+      else if (exponent >= -14 && exponent <= 15 && (mantissa & ((std::uint64_t(1) << 42) - 1)) == 0)
+        half = sign | static_cast<std::uint64_t>(exponent + 15) << 10 | mantissa >> 42;
+      else if (exponent >= -24 && exponent < -14)
+        return subnormal(mantissa, 28 - exponent, sign, half);
+      else
+        return false;
+      return true;
+    }
+
+    // Likewise in single precision, for finite nonzero numbers
+    static bool single_precision(std::uint64_t bits, std::uint64_t& single) {
+      const std::uint64_t sign = bits >> 63 << 31;
+      const int exponent = static_cast<int>(bits >> 52 & 0x7ff) - 1023;
+      const std::uint64_t mantissa = bits & ((std::uint64_t(1) << 52) - 1);
+      if (exponent >= -126 && exponent <= 127 && (mantissa & ((std::uint64_t(1) << 29) - 1)) == 0) {
+        single = sign | static_cast<std::uint64_t>(exponent + 127) << 23 | mantissa >> 29;
+        return true;
+      }
+      if (exponent >= -149 && exponent < -126)
+        return subnormal(mantissa, -97 - exponent, sign, single);
+      return false;
+    }
+
+    // A subnormal of a shorter format: the significand shifted right by
+    // shift, if no bits are lost
+    static bool subnormal(std::uint64_t mantissa, int shift, std::uint64_t sign, std::uint64_t& result) {
+      const std::uint64_t significand = mantissa | std::uint64_t(1) << 52;
+      if ((significand & ((std::uint64_t(1) << shift) - 1)) != 0)
+        return false;
+      result = sign | significand >> shift;
+      return true;
+    }
+
+    // The head of a CBOR data item: its major type and argument, in as few
+    // bytes as the argument fits
+    void write_head(unsigned major, std::uint64_t argument) {
+      char head[9];
+      size_t size = 1;
+      unsigned info = static_cast<unsigned>(argument);
+      if (argument >= 24) {
+        const unsigned scale = argument <= 0xff ? 0 : argument <= 0xffff ? 1 : argument <= 0xffffffff ? 2 : 3;
+        info = 24 + scale;
+        size = 1 + (size_t(1) << scale);
+        for (size_t i = size - 1; i > 0; i--, argument >>= 8)
+          head[i] = static_cast<char>(argument & 0xff);
+      }
+      head[0] = static_cast<char>(major << 5 | info);
+      write(std::string_view(head, size));
+    }
+
+    void write_tag(CaptureTag tag) {
+      if (format_ == OutputFormat::binary)
+        write_head(6, static_cast<std::uint64_t>(tag));
+    }
+
+    // Arrays and maps of machine-readable output, of size elements or
+    // entries. Binary ones of unknown_size are indefinite.
+    void begin_array(size_t size) {
+      if (format_ != OutputFormat::binary)
+        write('[');
+      else if (size == unknown_size)
+        write('\x9f');
+      else
+        write_head(4, size);
+    }
+
+    void end_array(size_t size) {
+      if (format_ != OutputFormat::binary)
+        write(']');
+      else if (size == unknown_size)
+        write('\xff');
+    }
+
+    void begin_map(size_t size) {
+      if (format_ != OutputFormat::binary)
+        write('{');
+      else if (size == unknown_size)
+        write('\xbf');
+      else
+        write_head(5, size);
+    }
+
+    void end_map(size_t size) {
+      if (format_ != OutputFormat::binary)
+        write('}');
+      else if (size == unknown_size)
+        write('\xff');
+    }
+
+    // Before the element or entry at index of an array or map
+    void separate(size_t index) {
+      if (index > 0 && format_ != OutputFormat::binary)
+        write(',');
+    }
+
+    // Length of value written in decimal, sign included
+    template <typename T>
+    static size_t decimal_digits(T value) {
+      typedef std::make_unsigned_t<T> U;
+      const bool negative = value < T(0);
+      U magnitude = negative ? U(U(0) - static_cast<U>(value)) : static_cast<U>(value);
+      size_t digits = negative ? 2 : 1;
+      for (; magnitude >= 10; magnitude /= 10)
+        digits += 1;
+      return digits;
+    }
+
+    template <typename T>
+    std::to_chars_result to_chars(char * first, char * last, T value) const {
+      if constexpr (std::is_integral_v<T>) {
+        return std::to_chars(first, last, value);
+      }
+      else {
+#if defined(__cpp_lib_to_chars)
+        if (precision_ < 0) {
+          switch (float_format_) {
+          case FloatFormat::fixed: return std::to_chars(first, last, value, std::chars_format::fixed);
+          case FloatFormat::scientific: return std::to_chars(first, last, value, std::chars_format::scientific);
+          case FloatFormat::general: return std::to_chars(first, last, value, std::chars_format::general, 6);
+          default: return std::to_chars(first, last, value);
+          }
+        }
+        switch (float_format_) {
+        case FloatFormat::fixed: return std::to_chars(first, last, value, std::chars_format::fixed, precision_);
+        case FloatFormat::scientific: return std::to_chars(first, last, value, std::chars_format::scientific, precision_);
+        default: return std::to_chars(first, last, value, std::chars_format::general, precision_);
+        }
+#else
+        // No floating point std::to_chars: printf, and for shortest the
+        // fewest of digits10 / max_digits10 digits that reads back exactly
+        const bool is_long = std::is_same_v<T, long double>;
+        const char * format = nullptr;
+        int precision = precision_;
+        switch (float_format_) {
+        case FloatFormat::fixed: format = is_long ? "%.*Lf" : "%.*f"; break;
+        case FloatFormat::scientific: format = is_long ? "%.*Le" : "%.*e"; break;
+        default: format = is_long ? "%.*Lg" : "%.*g"; break;
+        }
+        if (precision < 0)
+          precision = float_format_ == FloatFormat::shortest ? std::numeric_limits<T>::digits10 : 6;
+        const auto size = static_cast<size_t>(last - first);
+        int length = std::snprintf(first, size, format, precision, value);
+        if (float_format_ == FloatFormat::shortest && precision_ < 0 && length > 0 &&
+            static_cast<size_t>(length) < size && static_cast<T>(std::strtold(first, nullptr)) != value)
+          length = std::snprintf(first, size, format, std::numeric_limits<T>::max_digits10, value);
+        if (length < 0 || static_cast<size_t>(length) >= size)
+          return {last, std::errc::value_too_large};
+        return {first + length, std::errc()};
+#endif
+      }
+    }
+
+    // Machine-readable output ignores the stream's formatting
+    bool plain_stream() {
+      if (format_ != OutputFormat::text)
+        return true;
+      if (!stream_state_checked_) {
+        const auto flags = stream_.flags();
+        const auto changed = std::ios_base::floatfield | std::ios_base::showpos | std::ios_base::showpoint |
+          std::ios_base::uppercase | std::ios_base::showbase;
+        const auto base = flags & std::ios_base::basefield;
+        plain_stream_ = (flags & changed) == 0 && (base == std::ios_base::dec || base == 0) &&
+          stream_.precision() == 6 && stream_.getloc() == std::locale::classic();
+        stream_state_checked_ = true;
+      }
+      return plain_stream_;
+    }
+
+    // Mid-print flush: keeps the formatting state in sync
+    void flush_block() {
+      if (sink_)
+        return; // records reach a sink whole
+      if (target_)
+        target_(target_context_, buffer_);
+      else
+        stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+      buffer_.clear();
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value == true, void>::type
+    print_internal(T value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      write_indent(indent);
+      if constexpr (is_character<T>::value) {
+        if (format_ != OutputFormat::text)
+          write_number(+value); // character codes, signed and unsigned char bytes
+        else
+          write_formatted(value);
+      }
+      else {
+        write_number(value);
+      }
+      write(line_terminator);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_null_pointer<T>::value == true, void>::type
+    print_internal(T value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      write_indent(indent);
+      if (format_ == OutputFormat::binary)
+        write('\xf6');
+      else
+        write(format_ != OutputFormat::text ? "null" : "nullptr");
+      write(line_terminator);
+    }
+
+    void print_internal(float value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      write_indent(indent);
+      write_real(value);
+      if (format_ == OutputFormat::text)
+        write('f');
+      write(line_terminator);
+    }
+
+    void print_internal(double value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      write_indent(indent);
+      write_real(value);
+      write(line_terminator);
+    }
+
+    void print_internal(long double value, size_t indent = 0, std::string_view line_terminator = "\n",
+      size_t level = 0) {
+      write_indent(indent);
+      write_real(value);
+      write(line_terminator);
+    }
+
+    // JSON has no NaN or infinity, JSON and logfmt have null instead
+    template <typename T>
+    void write_real(T value) {
+      if ((format_ == OutputFormat::json || format_ == OutputFormat::logfmt) && !std::isfinite(value))
+        write("null");
+      else
+        write_number(value);
+    }
+
+    void print_internal(const std::string& value, size_t indent = 0, std::string_view line_terminator = "\n",
+      size_t level = 0) {
+      print_string(value, indent, line_terminator, level);
+    }
+
+    void print_internal(const char * value, size_t indent = 0, std::string_view line_terminator = "\n",
+      size_t level = 0) {
+      print_string(value, indent, line_terminator, level);
+    }
+
+    // Flat copies kept by deferred printing, printed like the originals
+
+    void print_internal(const FlatString& value, size_t indent = 0, std::string_view line_terminator = "\n",
+      size_t level = 0) {
+      print_string(std::string_view(value.data, value.size), indent, line_terminator, level);
+    }
+
+    void print_internal(const FlatText& value, size_t indent = 0, std::string_view line_terminator = "\n",
+      size_t level = 0) {
+      if (format_ != OutputFormat::text) {
+        write_tag(CaptureTag::text);
+        print_string(std::string_view(value.data, value.size), indent, line_terminator, level);
+      }
+      else {
+        print_internal_without_quotes(std::string_view(value.data, value.size), indent, line_terminator);
+      }
+    }
+
+    template <typename Element, bool Curly, bool ContainerElements>
+    void print_internal(const FlatSequence<Element, Curly, ContainerElements>& value, size_t indent = 0,
+      std::string_view line_terminator = "\n", size_t level = 0) {
+      print_elements(value.data, value.data + value.size, value.unknown_size ? unknown_size : value.size,
+        Curly ? "{" : "[", Curly ? "}" : "]", ContainerElements, element_printer(level), indent, level, compact_);
+    }
+
+    template <typename Key, typename Value, bool ContainerValues>
+    void print_internal(const FlatMap<Key, Value, ContainerValues>& value, size_t indent = 0,
+      std::string_view line_terminator = "\n", size_t level = 0) {
+      print_entries(value.begin(), value.end(), value.size, ContainerValues, indent, level, compact_);
+    }
+
+    void print_string(std::string_view value, size_t indent, std::string_view line_terminator, size_t level) {
+      write_indent(indent);
+      if (format_ != OutputFormat::text) {
+        write_text(value, level);
+        write(line_terminator);
+        return;
+      }
+      if (quotes_)
+        write('"');
+      write_string(value, quotes_ ? '"' : '\0');
+      if (quotes_)
+        write('"');
+      write(line_terminator);
+    }
+
+    // Text in machine-readable output: a JSON or CBOR string (a byte string
+    // when it is not valid UTF-8), or as it is at the top of a logfmt field
+    // (which print_field quotes if it has to)
+    void write_text(std::string_view value, size_t level) {
+      if (format_ == OutputFormat::binary) {
+        write_head(valid_utf8(value) ? 3 : 2, value.size());
+        write(value);
+        return;
+      }
+      if (format_ == OutputFormat::logfmt && level == 0) {
+        write(value);
+        return;
+      }
+      write('"');
+      write_escaped(value, '"');
+      write('"');
+    }
+
+    // Values machine-readable output has no encoding for are written as
+    // the text print() writes, as text
+    template <typename F>
+    void write_as_text(size_t level, F&& print) {
+      std::string text;
+      {
+        struct Restore {
+          PrettyPrinter& printer;
+          OutputFormat format;
+          ~Restore() {
+            printer.format_ = format;
+          }
+        } restore {*this, format_};
+        format_ = OutputFormat::text;
+        render_to(text, print);
+      }
+      write_tag(CaptureTag::text);
+      write_text(text, level);
+    }
+
+    // Writes value, cut to max_string_length (on a UTF-8 character
+    // boundary), escaped for quote unless quote is '\0'
+    void write_string(std::string_view value, char quote) {
+      const bool cut = value.size() > max_string_length_ && format_ == OutputFormat::text;
+      if (cut) {
+        size_t length = max_string_length_;
+        while (length > 0 && (static_cast<unsigned char>(value[length]) & 0xC0) == 0x80)
+          length -= 1;
+        value = value.substr(0, length);
+      }
+      if (quote == '\0')
+        write(value);
+      else
+        write_escaped(value, quote);
+      if (cut)
+        write("...");
+    }
+
+    // Writes value so that between quote characters it reads back as value:
+    // the quote, backslashes, control characters and bytes that are not
+    // valid UTF-8 are escaped, as are U+2028 and U+2029, which some readers
+    // take for line breaks. Plain runs are found by plain_prefix and
+    // written in one piece. Machine-readable output escapes as JSON does:
+    // control characters as \u00XX and invalid bytes as U+FFFD.
+    void write_escaped(std::string_view value, char quote) {
+      while (!value.empty()) {
+        size_t plain = plain_prefix(value, quote);
+        while (plain < value.size() && static_cast<unsigned char>(value[plain]) >= 0x80) {
+          const size_t length = utf8_length(value.substr(plain));
+          if (length == 0 || is_line_separator(value.substr(plain, length)))
+            break;
+          plain += length;
+          plain += plain_prefix(value.substr(plain), quote);
+        }
+        write(value.substr(0, plain));
+        value.remove_prefix(plain);
+        if (value.empty())
+          break;
+        const unsigned char byte = static_cast<unsigned char>(value[0]);
+        size_t escaped = 1;
+        switch (byte) {
+        case '\n': write("\\n"); break;
+        case '\r': write("\\r"); break;
+        case '\t': write("\\t"); break;
+        case '\\': write("\\\\"); break;
+        default:
+          if (value[0] == quote) {
+            write('\\');
+            write(quote);
+          }
+          else if (utf8_length(value) == 3 && is_line_separator(value.substr(0, 3))) {
+            write(value[2] == '\xa8' ? "\\u2028" : "\\u2029");
+            escaped = 3;
+          }
+          else if (format_ != OutputFormat::text && byte >= 0x80) {
+            write("\\ufffd");
+          }
+          else if (format_ != OutputFormat::text) {
+            const char digits[] = "0123456789abcdef";
+            const char escape[] = {'\\', 'u', '0', '0', digits[byte >> 4], digits[byte & 0xf]};
+            write(std::string_view(escape, sizeof(escape)));
+          }
+          else {
+            const char digits[] = "0123456789abcdef";
+            const char escape[] = {'\\', 'x', digits[byte >> 4], digits[byte & 0xf]};
+            write(std::string_view(escape, sizeof(escape)));
+          }
+        }
+        value.remove_prefix(escaped);
+      }
+    }
+
+    static bool is_line_separator(std::string_view character) {
+      return character == "\xe2\x80\xa8" || character == "\xe2\x80\xa9";
+    }
+
+    void print_internal(char value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      if (format_ != OutputFormat::text) {
+        write_tag(CaptureTag::character);
+        print_string(std::string_view(&value, 1), indent, line_terminator, level);
+      }
+      else if (!quotes_)
+        print_internal_without_quotes(value, indent, line_terminator, level);
+      else {
+        write_indent(indent);
+        write('\'');
+        write_escaped(std::string_view(&value, 1), '\'');
+        write('\'');
+        write(line_terminator);
+      }
+    }
+
+    void print_internal_without_quotes(std::string_view value, size_t indent = 0,
+      std::string_view line_terminator = "\n", size_t level = 0) {
+      write_indent(indent);
+      write(value);
+      write(line_terminator);
+    }
+
+    void print_internal_without_quotes(char value, size_t indent = 0, std::string_view line_terminator = "\n",
+      size_t level = 0) {
+      write_indent(indent);
+      write(value);
+      write(line_terminator);
+    }
+
+    void print_internal(bool value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      write_indent(indent);
+      if (format_ == OutputFormat::binary)
+        write(value ? '\xf5' : '\xf4');
+      else
+        write(value ? "true" : "false");
+      write(line_terminator);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_pointer<T>::value == true, void>::type
+    print_internal(T value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      if (value == nullptr) {
+        return print_internal(nullptr, indent, line_terminator, level);
+      }
+      write_indent(indent);
+      if (format_ != OutputFormat::text) {
+        write_as_text(level, [&] { print_internal(value, 0, "", level); });
+        write(line_terminator);
+        return;
+      }
+      write('<');
+      write(type(value));
+      write(" at ");
+      write_formatted(value);
+      write('>');
+      write(line_terminator);
+    }
+
+    template <class T>
+    std::string_view type(const T&) {
+      return type_name<T>();
+    }
+
+    // Enumerations are printed by pprint/enum.hpp
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value == true, void>::type
+    print_internal(T value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      print_category(value, indent, line_terminator, level, category::enumeration {});
+    }
+
+    // Class types without an overload of their own are printed according to
+    // their category_of tag
+    template <typename T>
+    typename std::enable_if<std::is_class<T>::value == true, void>::type
+    print_internal(const T& value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      print_category(value, indent, line_terminator, level, typename category_of<T>::type {});
+    }
+
+    // Categories of the family headers
+    template <typename T, typename Category>
+    void print_category(const T& value, size_t indent, std::string_view line_terminator, size_t level, Category) {
+      category_printer<Category>::print(*this, value, indent, line_terminator, level);
+    }
+
+    template <typename T>
+    void print_category(const T& value, size_t indent, std::string_view line_terminator, size_t level,
+            category::streamable) {
+      write_indent(indent);
+      if (format_ != OutputFormat::text)
+        write_as_text(level, [&] { write_formatted(value); });
+      else
+        write_formatted(value);
+      write(line_terminator);
+    }
+
+    template <typename T>
+    void print_category(const T& value, size_t indent, std::string_view line_terminator, size_t level,
+            category::object) {
+      write_indent(indent);
+      if (format_ != OutputFormat::text) {
+        write_as_text(level, [&] { print_category(value, 0, "", level, category::object {}); });
+        write(line_terminator);
+        return;
+      }
+      write("<Object ");
+      write(type(value));
+      write('>');
+      write(line_terminator);
+    }
+
+    // Any other range without an operator<< (std::forward_list, views, user
+    // containers) is printed like a std::vector
+    template <typename T>
+    void print_category(const T& value, size_t indent, std::string_view line_terminator, size_t level,
+            category::range) {
+      print_internal(range(value), indent, line_terminator, level);
+    }
+
+    template <typename Iterator, typename Sentinel>
+    void print_internal(const Range<Iterator, Sentinel>& value, size_t indent = 0,
+            std::string_view line_terminator = "\n", size_t level = 0) {
+      typedef std::remove_cv_t<std::remove_reference_t<decltype(*value.begin())>> T;
+      print_elements(value.begin(), value.end(), value.size(), "[", "]", is_container<T>::value,
+        element_printer(level), indent, level, compact_);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_member_function_pointer<T>::value == true, void>::type
+    print_internal(T value, size_t indent = 0, std::string_view line_terminator = "\n", size_t level = 0) {
+      write_indent(indent);
+      if (format_ != OutputFormat::text) {
+        write_as_text(level, [&] { print_internal(value, 0, "", level); });
+        write(line_terminator);
+        return;
+      }
+      write("<Object.method ");
+      write(type(value));
+      write(" at ");
+      write_formatted(&value);
+      write('>');
+      write(line_terminator);
+    }
+
+    template <typename Container>
+    void print_category(const Container& value, size_t indent, std::string_view line_terminator, size_t level,
+            category::sequence) {
+      typedef typename Container::value_type T;
+      print_elements(std::begin(value), std::end(value), value.size(), "[", "]", is_container<T>::value,
+        element_printer(level), indent, level, compact_);
+    }
+
+    template <typename Key, typename Value>
+    void print_internal(const std::pair<Key, Value>& value, size_t indent = 0, std::string_view line_terminator = "\n",
+            size_t level = 0) {
+      print_pair(value.first, value.second, indent, line_terminator, level);
+    }
+
+    template <typename First, typename Second>
+    void print_pair(const First& first, const Second& second, size_t indent, std::string_view line_terminator,
+            size_t level) {
+      if (format_ != OutputFormat::text) {
+        write_indent(indent);
+        write_tag(CaptureTag::pair);
+        begin_array(2);
+        print_internal(first, 0, "", level + 1);
+        separate(1);
+        print_internal(second, 0, "", level + 1);
+        end_array(2);
+        write(line_terminator);
+        return;
+      }
+      print_internal_without_quotes("(", indent, "");
+      print_internal(first, 0, "", level);
+      print_internal_without_quotes(", ", 0, "");
+      print_internal(second, 0, "", level);
+      print_internal_without_quotes(")", 0, line_terminator, level);
+    }
+
+    template <typename T>
+    void print_internal(const std::optional<T>& value, size_t indent = 0,
+        std::string_view line_terminator = "\n", size_t level = 0) {
+      if (value) {
+        print_internal(value.value(), indent, line_terminator, level);
+      }
+      else if (format_ == OutputFormat::binary) {
+        print_internal_without_quotes('\xf7', indent, line_terminator, level); // undefined
+      }
+      else {
+        print_internal_without_quotes(format_ != OutputFormat::text ? "null" : "nullopt", indent, line_terminator,
+          level);
+      }
+    }
+
+    // Prints [first, last) between open and close: one element per line at
+    // level 0, unless compact, and on one line otherwise. Elements are
+    // visited once, in order, so single-pass iterators work. size is only
+    // used to count elided elements and may be unknown_size.
+    // print_element(printer, element, indent, line_terminator) prints a
+    // single element with printer. At most max_items elements are visited, the rest are counted
+    // in an elision marker; below max_depth only "[...]" is printed.
+    // Machine-readable output is a JSON array of every element.
+    template <typename Iterator, typename Sentinel, typename PrintElement>
+    void print_elements(Iterator first, Sentinel last, size_t size, std::string_view open,
+            std::string_view close, bool container_elements, PrintElement print_element, size_t indent,
+            size_t level, bool compact) {
+      if (format_ != OutputFormat::text) {
+        write_indent(indent);
+        if (open == "{")
+          write_tag(CaptureTag::set);
+        if (container_elements)
+          write_tag(CaptureTag::nested);
+        begin_array(size);
+        if (print_in_parallel<Iterator, Sentinel>(size)) {
+          print_parallel(first, size, [&](PrettyPrinter& printer, const auto& element, size_t index) {
+            printer.separate(index);
+            print_element(printer, element, 0, "");
+          });
+        }
+        else {
+          for (size_t index = 0; first != last; ++first, index++) {
+            separate(index);
+            print_element(*this, *first, 0, "");
+          }
+        }
+        end_array(size);
+        return;
+      }
+      if (level >= max_depth_) {
+        write_indent(indent);
+        write(open);
+        write("...");
+        write(close);
+        if (level == 0)
+          write(line_terminator_);
+        return;
+      }
+      if (layout_) {
+        // The elements form a group of the layout, on one line if it fits
+        write_indent(indent);
+        write(open);
+        if (first != last) {
+          begin_group(indent_);
+          line_break(0, 0);
+          for (size_t shown = 0; first != last; ++first, shown++) {
+            if (shown > 0) {
+              write(',');
+              line_break(1, 0);
+            }
+            if (shown == max_items_) {
+              write_elided(size, shown);
+              break;
+            }
+            print_element(*this, *first, 0, "");
+          }
+          line_break(0, -static_cast<long>(indent_));
+          end_group();
+        }
+        write(close);
+        if (level == 0)
+          write(line_terminator_);
+        return;
+      }
+      const bool empty = first == last;
+      bool elided = false;
+      if (level == 0 && !compact) {
+        write(open);
+        if (!empty) {
+          // The layout depends on whether a second element follows the
+          // first, so look one element ahead
+          Lookahead<Iterator> current;
+          if (print_in_parallel<Iterator, Sentinel>(size)) {
+            write('\n');
+            const size_t shown = std::min(size, max_items_);
+            print_parallel(first, shown,
+              [&](PrettyPrinter& printer, const auto& element, size_t index) {
+                if (index + 1 == size) {
+                  print_element(printer, element, indent + indent_, "\n");
+                }
+                else {
+                  print_element(printer, element, indent + indent_, "");
+                  printer.write(", \n");
+                }
+              });
+            if (shown < size) {
+              write_indent(indent + indent_);
+              write_elided(size, shown);
+              write('\n');
+              elided = true;
+            }
+          }
+          else if (max_items_ == 0) {
+            write_elided(size, 0);
+            elided = true;
+          }
+          else if (current.take(first), first == last) {
+            print_element(*this, current.get(), 0, "");
+          }
+          else {
+            write('\n');
+            for (size_t shown = 1; ; shown++) {
+              if (first == last) {
+                print_element(*this, current.get(), indent + indent_, "\n");
+                break;
+              }
+              print_element(*this, current.get(), indent + indent_, "");
+              write(", \n");
+              if (shown == max_items_) {
+                write_indent(indent + indent_);
+                write_elided(size, shown);
+                write('\n');
+                elided = true;
+                break;
+              }
+              current.take(first);
+            }
+          }
+        }
+        write_indent(indent);
+        if (!empty && !elided && container_elements)
+          write(line_terminator_);
+        write(close);
+        write(line_terminator_);
+      }
+      else {
+        write_indent(indent);
+        write(open);
+        if (print_in_parallel<Iterator, Sentinel>(size)) {
+          const size_t shown = std::min(size, max_items_);
+          print_parallel(first, shown, [&](PrettyPrinter& printer, const auto& element, size_t index) {
+            if (index > 0)
+              printer.write(", ");
+            print_element(printer, element, 0, "");
+          });
+          if (shown < size) {
+            write(", ");
+            write_elided(size, shown);
+          }
+        }
+        else {
+          for (size_t shown = 0; first != last; ++first, shown++) {
+            if (shown > 0)
+              write(", ");
+            if (shown == max_items_) {
+              write_elided(size, shown);
+              break;
+            }
+            print_element(*this, *first, 0, "");
+          }
+        }
+        write(close);
+        if (level == 0 && compact)
+          write(line_terminator_);
+      }
+    }
+
+    // Whether print_elements splits a range of size elements between threads:
+    // the range must be multi-pass and at least parallel_threshold elements
+    // must be shown
+    template <typename Iterator, typename Sentinel>
+    bool print_in_parallel(size_t size) const {
+      if constexpr (std::is_same_v<Iterator, Sentinel> &&
+          has_iterator_category<Iterator, std::forward_iterator_tag>::value)
+        return parallel_ && size != unknown_size &&
+          std::min(size, item_limit()) >= std::max(parallel_threshold_, size_t(2));
+      else
+        return false;
+    }
+
+    // Prints count elements from first with print_one(printer, element,
+    // index). Chunks of elements are printed by copies of this printer, each
+    // into a buffer of its own, and written in order. Chunks go to the pool
+    // a few per thread at a time, which bounds the memory held in buffers.
+    template <typename Iterator, typename PrintOne>
+    void print_parallel(const Iterator& first, size_t count, PrintOne print_one) {
+      if constexpr (has_iterator_category<Iterator, std::forward_iterator_tag>::value) {
+        ThreadPool& pool = ThreadPool::shared();
+        const size_t chunk = std::clamp(count / (pool.size() * 8), size_t(1024), size_t(1) << 16);
+        std::vector<std::string> outputs(pool.size() * 2);
+        std::vector<Iterator> starts;
+        Iterator position = first;
+        for (size_t done = 0; done < count; ) {
+          starts.clear();
+          for (size_t next = done; starts.size() < outputs.size() && next < count; next += chunk) {
+            starts.push_back(position);
+            std::advance(position, static_cast<std::ptrdiff_t>(std::min(chunk, count - next)));
+          }
+          pool.run(starts.size(), [&, done](size_t index) {
+            PrettyPrinter printer(*this);
+            printer.parallel_ = false;
+            printer.flush_threshold_ = std::numeric_limits<size_t>::max();
+            // Hands the buffer back however printing returns
+            struct Output {
+              PrettyPrinter& printer;
+              std::string& output;
+              ~Output() {
+                printer.buffer_.swap(output);
+              }
+            } output {printer, outputs[index]};
+            output.output.clear();
+            printer.buffer_.swap(output.output);
+            Iterator element = starts[index];
+            const size_t begin = done + index * chunk, end = std::min(begin + chunk, count);
+            for (size_t i = begin; i < end; ++i, ++element)
+              print_one(printer, *element, i);
+          });
+          for (size_t index = 0; index < starts.size(); index++)
+            write(outputs[index]);
+          done = std::min(done + starts.size() * chunk, count);
+        }
+      }
+    }
+
+    // Elements shown of each container: max_items, but all of them in
+    // machine-readable output
+    size_t item_limit() const {
+      return format_ != OutputFormat::text ? std::numeric_limits<size_t>::max() : max_items_;
+    }
+
+    // Prints the entries of a map, std::pairs or FlatEntries from first to
+    // last: {key : value, ...} laid out like other containers, or a JSON
+    // object. Keys of an object that are not text are strings holding
+    // their JSON.
+    template <typename Iterator>
+    void print_entries(Iterator first, Iterator last, size_t size, bool container_values, size_t indent,
+            size_t level, bool compact) {
+      if (format_ == OutputFormat::text) {
+        print_elements(first, last, size, "{", "}", container_values,
+          [level](PrettyPrinter& printer, const auto& entry, size_t indent, std::string_view line_terminator) {
+            printer.print_internal(entry_key(entry), indent, "", level + 1);
+            printer.write(" : ");
+            printer.print_internal(entry_value(entry), 0, line_terminator, level + 1);
+          }, indent, level, compact);
+        return;
+      }
+      auto print_entry = [level](PrettyPrinter& printer, const auto& entry, size_t index) {
+        printer.separate(index);
+        printer.print_key(entry_key(entry), level + 1);
+        if (printer.format_ != OutputFormat::binary)
+          printer.write(':');
+        printer.print_internal(entry_value(entry), 0, "", level + 1);
+      };
+      write_indent(indent);
+      if (container_values)
+        write_tag(CaptureTag::nested);
+      begin_map(size);
+      if (print_in_parallel<Iterator, Iterator>(size)) {
+        print_parallel(first, size, print_entry);
+      }
+      else {
+        for (size_t index = 0; first != last; ++first, index++)
+          print_entry(*this, *first, index);
+      }
+      end_map(size);
+    }
+
+    // Binary maps keep their keys as they are
+    template <typename Key>
+    void print_key(const Key& key, size_t level) {
+      if constexpr (std::is_same_v<Key, std::string> || std::is_same_v<Key, FlatString> ||
+          std::is_same_v<Key, char> || is_char_pointer<Key>::value) {
+        print_internal(key, 0, "", level);
+      }
+      else if (format_ == OutputFormat::binary) {
+        print_internal(key, 0, "", level);
+      }
+      else {
+        std::string text;
+        render_to(text, [&] { print_internal(key, 0, "", level); });
+        if (!text.empty() && text[0] == '"')
+          write(text);
+        else
+          write_text(text, level);
+      }
+    }
+
+    // print_elements printer for values printed one level down as they are
+    template <typename Projection = identity>
+    auto element_printer(size_t level, Projection project = Projection()) {
+      return [level, project](PrettyPrinter& printer, const auto& element, size_t indent,
+          std::string_view line_terminator) {
+        printer.print_internal(project(element), indent, line_terminator, level + 1);
+      };
+    }
+
+    // "... 9997 more", or "..." when the size of the range is unknown
+    void write_elided(size_t size, size_t shown) {
+      write("...");
+      if (size == unknown_size)
+        return;
+      char digits[24];
+      const auto result = std::to_chars(digits, digits + sizeof(digits), size - shown);
+      write(' ');
+      write(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+      write(" more");
+    }
+
+    // Arrays other than character arrays are printed like a std::array
+    template <typename T, std::size_t N>
+    std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, char>>
+    print_internal(const T (&value)[N], size_t indent = 0, std::string_view line_terminator = "\n",
+            size_t level = 0) {
+      print_elements(value, value + N, N, "[", "]", is_container<T>::value, element_printer(level), indent, level,
+        compact_);
+    }
+
+    // Initializer lists are printed in the order they were written, like a std::vector
+    template <typename T>
+    void print_internal(std::initializer_list<T> value, size_t indent = 0,
+            std::string_view line_terminator = "\n", size_t level = 0) {
+      print_elements(value.begin(), value.end(), value.size(), "[", "]", is_container<T>::value,
+        element_printer(level), indent, level, compact_);
+    }
+
+    template<class... Args>
+    void print_internal(const std::tuple<Args...>& value, size_t indent = 0, std::string_view line_terminator = "\n",
+            size_t level = 0) {
+      write_indent(indent);
+      if (format_ != OutputFormat::text) {
+        write_tag(CaptureTag::tuple);
+        begin_array(sizeof...(Args));
+      }
+      else {
+        write('(');
+      }
+      size_t index = 0;
+      std::apply([&](const auto&... elements) { (print_tuple_element(elements, index++, level), ...); }, value);
+      if (format_ != OutputFormat::text)
+        end_array(sizeof...(Args));
+      else
+        write(')');
+      write(line_terminator);
+    }
+
+    // Tuple elements are printed as the std::tuple operator<< prints them:
+    // chars and strings always quoted, floats without a suffix
+    template <typename T>
+    void print_tuple_element(const T& element, size_t index, size_t level) {
+      if (format_ != OutputFormat::text) {
+        separate(index);
+        print_internal(element, 0, "", level + 1);
+        return;
+      }
+      if (index > 0)
+        write(", ");
+      if constexpr (std::is_same_v<T, char>) {
+        write('\'');
+        write_escaped(std::string_view(&element, 1), '\'');
+        write('\'');
+      }
+      else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, const char *>) {
+        write('"');
+        write_string(element, '"');
+        write('"');
+      }
+      else if constexpr (std::is_same_v<T, FlatString>) {
+        write('"');
+        write_string(std::string_view(element.data, element.size), '"');
+        write('"');
+      }
+      else if constexpr (std::is_same_v<T, FlatText>)
+        write(std::string_view(element.data, element.size));
+      else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !is_character<T>::value)
+        write_number(element);
+      else if constexpr (is_to_stream_writable<std::ostream, T>::value)
+        write_formatted(element);
+      else
+        print_internal(element, 0, "", level + 1);
+    }
+
+    // Machine-readable output holds what a smart pointer points to, or
+    // null; captures keep its text as well, to render it as text
+    template<typename Pointer>
+    void print_category(const Pointer& value, size_t indent, std::string_view line_terminator, size_t level,
+            category::smart_pointer) {
+      write_indent(indent);
+      if (format_ == OutputFormat::text) {
+        write_pointer_text(value);
+      }
+      else if (format_ == OutputFormat::binary) {
+        write_tag(CaptureTag::pointer);
+        begin_array(2);
+        write_as_text(level, [&] { write_pointer_text(value); });
+        print_pointee(value, level);
+        end_array(2);
+      }
+      else {
+        print_pointee(value, level);
+      }
+      write(line_terminator);
+    }
+
+    template<typename Pointer>
+    void write_pointer_text(const Pointer& value) {
+      write('<');
+      write(type(value));
+      write(" at ");
+      write_formatted(&value);
+      write('>');
+    }
+
+    template<typename Pointer>
+    void print_pointee(const Pointer& value, size_t level) {
+      if constexpr (is_specialization<Pointer, std::weak_ptr>::value) {
+        print_pointee(value.lock(), level);
+      }
+      else if constexpr (has_pointee<Pointer>::value) {
+        if (value)
+          print_internal(*value, 0, "", level);
+        else
+          print_internal(nullptr, 0, "", level);
+      }
+      else if (value) {
+        // void and array pointees
+        write_as_text(level, [&] { write_pointer_text(value); });
+      }
+      else {
+        print_internal(nullptr, 0, "", level);
+      }
+    }
+
+  };
+
+  template <typename T>
+  void PrettyPrinter::print_value(const T& value, size_t indent, std::string_view line_terminator) {
+    print_internal(value, indent, line_terminator, 0);
+  }
+
+  // Returns the text print(value) writes, formatted with the settings of
+  // options. No stream is involved: output is rendered into the string
+  // that is returned, and numbers follow a stream's default formatting.
+  template <typename T>
+  std::string pformat(const T& value, const PrettyPrinter& options) {
+    std::string result;
+    {
+      PrettyPrinter printer(options, [](void * context, std::string& buffer) {
+        std::string& result = *static_cast<std::string*>(context);
+        if (result.empty())
+          result.swap(buffer);
+        else
+          result.append(buffer);
+      }, &result);
+      printer.buffer_.reserve(256);
+      printer.print(value);
+    }
+    return result;
+  }
+
+  template <typename T>
+  std::string pformat(const T& value) {
+    return pformat(value, PrettyPrinter());
+  }
+
+  // Writes the text print(value) writes to out, like pformat, and returns
+  // the iterator past it. Output is rendered in blocks of up to
+  // flush_threshold bytes, each copied through the iterator.
+  template <typename OutputIt, typename T>
+  OutputIt format_to(OutputIt out, const T& value, const PrettyPrinter& options) {
+    {
+      PrettyPrinter printer(options, [](void * context, std::string& buffer) {
+        OutputIt& out = *static_cast<OutputIt*>(context);
+        out = std::copy(buffer.begin(), buffer.end(), out);
+      }, &out);
+      printer.print(value);
+    }
+    return out;
+  }
+
+  template <typename OutputIt, typename T>
+  OutputIt format_to(OutputIt out, const T& value) {
+    return format_to(out, value, PrettyPrinter());
+  }
+
+}
@@ -0,0 +1,518 @@
+// pprint/enum.hpp: enumerations, named with magic_enum or pprint::enum_traits
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "core.hpp"
+#include <array>
+
+// Enum value must be greater or equals than MAGIC_ENUM_RANGE_MIN. By default MAGIC_ENUM_RANGE_MIN = -128.
+// If need another min range for all enum types by default, redefine the macro MAGIC_ENUM_RANGE_MIN.
+#if !defined(MAGIC_ENUM_RANGE_MIN)
+#  define MAGIC_ENUM_RANGE_MIN -128
+#endif
+
+// Enum value must be less or equals than MAGIC_ENUM_RANGE_MAX. By default MAGIC_ENUM_RANGE_MAX = 128.
+// If need another max range for all enum types by default, redefine the macro MAGIC_ENUM_RANGE_MAX.
+#if !defined(MAGIC_ENUM_RANGE_MAX)
+#  define MAGIC_ENUM_RANGE_MAX 128
+#endif
+
+namespace magic_enum {
+
+  // Enum value must be in range [-MAGIC_ENUM_RANGE_MAX, MAGIC_ENUM_RANGE_MIN]. By default  MAGIC_ENUM_RANGE_MIN = -128, MAGIC_ENUM_RANGE_MAX = 128.
+  // If need another range for all enum types by default, redefine the macro MAGIC_ENUM_RANGE_MAX and MAGIC_ENUM_RANGE_MIN.
+  // If need another range for specific enum type, add specialization enum_range for necessary enum type.
+  template <typename E>
+  struct enum_range final {
+    static_assert(std::is_enum_v<E>, "magic_enum::enum_range requires enum type.");
+    static constexpr int min = std::is_signed_v<std::underlying_type_t<E>> ? MAGIC_ENUM_RANGE_MIN : 0;
+    static constexpr int max = MAGIC_ENUM_RANGE_MAX;
+  };
+
+  static_assert(MAGIC_ENUM_RANGE_MAX > 0,
+    "MAGIC_ENUM_RANGE_MAX must be greater than 0.");
+  static_assert(MAGIC_ENUM_RANGE_MAX < std::numeric_limits<int>::max(),
+    "MAGIC_ENUM_RANGE_MAX must be less than INT_MAX.");
+
+  static_assert(MAGIC_ENUM_RANGE_MIN <= 0,
+    "MAGIC_ENUM_RANGE_MIN must be less or equals than 0.");
+  static_assert(MAGIC_ENUM_RANGE_MIN > std::numeric_limits<int>::min(),
+    "MAGIC_ENUM_RANGE_MIN must be greater than INT_MIN.");
+
+  namespace detail {
+
+    template <typename E, typename U = std::underlying_type_t<E>>
+    [[nodiscard]] constexpr int min_impl() {
+      static_assert(std::is_enum_v<E>, "magic_enum::detail::min_impl requires enum type.");
+      constexpr int min = enum_range<E>::min > (std::numeric_limits<U>::min)() ? enum_range<E>::min : (std::numeric_limits<U>::min)();
+
+      return min;
+    }
+
+    template <typename E, typename U = std::underlying_type_t<E>>
+    [[nodiscard]] constexpr decltype(auto) range_impl() {
+      static_assert(std::is_enum_v<E>, "magic_enum::detail::range_impl requires enum type.");
+      static_assert(enum_range<E>::max > enum_range<E>::min, "magic_enum::enum_range requires max > min.");
+      constexpr int max = enum_range<E>::max < (std::numeric_limits<U>::max)() ? enum_range<E>::max : (std::numeric_limits<U>::max)();
+      constexpr auto range = std::make_integer_sequence<int, max - min_impl<E>() + 1>{};
+
+      return range;
+    }
+
+
+    [[nodiscard]] constexpr bool is_name_char(char c, bool front) noexcept {
+      return (!front && c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    template <typename E, E V>
+    [[nodiscard]] constexpr std::string_view name_impl() noexcept {
+      static_assert(std::is_enum_v<E>, "magic_enum::detail::name_impl requires enum type.");
+#if defined(__clang__)
+      std::string_view name{__PRETTY_FUNCTION__};
+      constexpr auto suffix = sizeof("]") - 1;
+#elif defined(__GNUC__) && __GNUC__ >= 9
+      std::string_view name{__PRETTY_FUNCTION__};
+      constexpr auto suffix = sizeof("; std::string_view = std::basic_string_view<char>]") - 1;
+#elif defined(_MSC_VER)
+      std::string_view name{__FUNCSIG__};
+      constexpr auto suffix = sizeof(">(void) noexcept") - 1;
+#else
+      return {}; // Unsupported compiler.
+#endif
+
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9) || defined(_MSC_VER)
+      name.remove_suffix(suffix);
+      for (std::size_t i = name.size(); i > 0; --i) {
+        if (!is_name_char(name[i - 1], false)) {
+        name.remove_prefix(i);
+        break;
+      }
+    }
+
+    if (name.length() > 0 && is_name_char(name.front(), true)) {
+      return name;
+      } else {
+        return {}; // Value does not have name.
+      }
+#endif
+    }
+
+    template <typename E, int... I>
+    [[nodiscard]] constexpr decltype(auto) strings_impl(std::integer_sequence<int, I...>) noexcept {
+      static_assert(std::is_enum_v<E>, "magic_enum::detail::strings_impl requires enum type.");
+      constexpr std::array<std::string_view, sizeof...(I)> names{{name_impl<E, static_cast<E>(I + min_impl<E>())>()...}};
+
+      return names;
+    }
+
+    template <typename E>
+    [[nodiscard]] constexpr std::string_view name_impl(int value) noexcept {
+      static_assert(std::is_enum_v<E>, "magic_enum::detail::name_impl requires enum type.");
+      constexpr auto names = strings_impl<E>(range_impl<E>());
+      const int i = value - min_impl<E>();
+
+      if (i >= 0 && static_cast<std::size_t>(i) < names.size()) {
+        return names[i];
+      } else {
+        return {}; // Value out of range.
+      }
+    }
+
+    template <typename E, int... I>
+    [[nodiscard]] constexpr decltype(auto) values_impl(std::integer_sequence<int, I...>) noexcept {
+      static_assert(std::is_enum_v<E>, "magic_enum::detail::values_impl requires enum type.");
+      constexpr int n = sizeof...(I);
+      constexpr std::array<bool, n> valid{{!name_impl<E, static_cast<E>(I + min_impl<E>())>().empty()...}};
+      constexpr int num_valid = ((valid[I] ? 1 : 0) + ...);
+
+      std::array<E, num_valid> enums{};
+      for (int i = 0, v = 0; i < n && v < num_valid; ++i) {
+        if (valid[i]) {
+          enums[v++] = static_cast<E>(i + min_impl<E>());
+        }
+      }
+
+      return enums;
+    }
+
+    template <typename E, std::size_t... I>
+    [[nodiscard]] constexpr decltype(auto) names_impl(std::integer_sequence<std::size_t, I...>) noexcept {
+      static_assert(std::is_enum_v<E>, "magic_enum::detail::names_impl requires enum type.");
+      constexpr auto enums = values_impl<E>(range_impl<E>());
+      constexpr std::array<std::string_view, sizeof...(I)> names{{name_impl<E, enums[I]>()...}};
+
+      return names;
+    }
+
+    template <typename E>
+    [[nodiscard]] constexpr std::optional<E> enum_cast_impl(std::string_view value) noexcept {
+      static_assert(std::is_enum_v<E>, "magic_enum::detail::enum_cast_impl requires enum type.");
+      constexpr auto values = values_impl<E>(range_impl<E>());
+      constexpr auto count = values.size();
+      constexpr auto names = names_impl<E>(std::make_index_sequence<count>{});
+
+      for (std::size_t i = 0; i < count; ++i) {
+        if (names[i] == value) {
+          return values[i];
+        }
+      }
+
+      return std::nullopt; // Invalid value or out of range.
+    }
+
+    template<typename T>
+    using enable_if_enum_t = typename std::enable_if<std::is_enum_v<T>>::type;
+
+    template<typename T, bool = std::is_enum_v<T>>
+    struct is_scoped_enum_impl : std::false_type {};
+
+    template<typename T>
+    struct is_scoped_enum_impl<T, true> : std::bool_constant<!std::is_convertible_v<T, std::underlying_type_t<T>>> {};
+
+    template<typename T, bool = std::is_enum_v<T>>
+    struct is_unscoped_enum_impl : std::false_type {};
+
+    template<typename T>
+    struct is_unscoped_enum_impl<T, true> : std::bool_constant<std::is_convertible_v<T, std::underlying_type_t<T>>> {};
+
+  } // namespace magic_enum::detail
+
+  // Checks whether T is an Unscoped enumeration type.
+  // Provides the member constant value which is equal to true, if T is an [Unscoped enumeration](https://en.cppreference.com/w/cpp/language/enum#Unscoped_enumeration) type.
+  // Otherwise, value is equal to false.
+  template <typename T>
+  struct is_unscoped_enum : detail::is_unscoped_enum_impl<T> {};
+
+  template <typename T>
+  inline constexpr bool is_unscoped_enum_v = is_unscoped_enum<T>::value;
+
+  // Checks whether T is an Scoped enumeration type.
+  // Provides the member constant value which is equal to true, if T is an [Scoped enumeration](https://en.cppreference.com/w/cpp/language/enum#Scoped_enumerations) type.
+  // Otherwise, value is equal to false.
+  template <typename T>
+  struct is_scoped_enum : detail::is_scoped_enum_impl<T> {};
+
+  template <typename T>
+  inline constexpr bool is_scoped_enum_v = is_scoped_enum<T>::value;
+
+  // Obtains enum value from enum string name.
+  template <typename E, typename = detail::enable_if_enum_t<E>>
+  [[nodiscard]] constexpr std::optional<E> enum_cast(std::string_view value) noexcept {
+    static_assert(std::is_enum_v<E>, "magic_enum::enum_cast requires enum type.");
+
+    return detail::enum_cast_impl<E>(value);
+  }
+
+  // Obtains enum value from integer value.
+  template <typename E, typename = detail::enable_if_enum_t<E>>
+  [[nodiscard]] constexpr std::optional<E> enum_cast(std::underlying_type_t<E> value) noexcept {
+    static_assert(std::is_enum_v<E>, "magic_enum::enum_cast requires enum type.");
+
+    if (detail::name_impl<E>(static_cast<int>(value)).empty()) {
+      return std::nullopt; // Invalid value or out of range.
+    } else {
+      return static_cast<E>(value);
+    }
+  }
+
+  // Returns enum value at specified index.
+  // No bounds checking is performed: the behavior is undefined if index >= number of enum values.
+  template<typename E, typename = detail::enable_if_enum_t<E>>
+  [[nodiscard]] constexpr E enum_value(std::size_t index) {
+    static_assert(std::is_enum_v<E>, "magic_enum::enum_value requires enum type.");
+    constexpr auto values = detail::values_impl<E>(detail::range_impl<E>());
+
+    return assert(index < values.size()), values[index];
+  }
+
+  // Obtains value enum sequence.
+  template <typename E, typename = detail::enable_if_enum_t<E>>
+  [[nodiscard]] constexpr decltype(auto) enum_values() noexcept {
+    static_assert(std::is_enum_v<E>, "magic_enum::enum_values requires enum type.");
+    constexpr auto values = detail::values_impl<E>(detail::range_impl<E>());
+
+    return values;
+  }
+
+  // Returns number of enum values.
+  template <typename E, typename = detail::enable_if_enum_t<E>>
+  [[nodiscard]] constexpr std::size_t enum_count() noexcept {
+    static_assert(std::is_enum_v<E>, "magic_enum::enum_count requires enum type.");
+    constexpr auto count = detail::values_impl<E>(detail::range_impl<E>()).size();
+
+    return count;
+  }
+
+  // Obtains string enum name from enum value.
+  template <typename E, typename D = std::decay_t<E>, typename = detail::enable_if_enum_t<D>>
+  [[nodiscard]] constexpr std::optional<std::string_view> enum_name(E value) noexcept {
+    static_assert(std::is_enum_v<D>, "magic_enum::enum_name requires enum type.");
+    const auto name = detail::name_impl<D>(static_cast<int>(value));
+
+    if (name.empty()) {
+      return std::nullopt; // Invalid value or out of range.
+    } else {
+      return name;
+    }
+  }
+
+  // Obtains string enum name sequence.
+  template <typename E, typename = detail::enable_if_enum_t<E>>
+  [[nodiscard]] constexpr decltype(auto) enum_names() noexcept {
+    static_assert(std::is_enum_v<E>, "magic_enum::enum_names requires enum type.");
+    constexpr auto count = detail::values_impl<E>(detail::range_impl<E>()).size();
+    constexpr auto names = detail::names_impl<E>(std::make_index_sequence<count>{});
+
+    return names;
+  }
+
+  namespace ops {
+
+    template <typename E, typename D = std::decay_t<E>, typename = detail::enable_if_enum_t<E>>
+    std::ostream& operator<<(std::ostream& os, E value) {
+      static_assert(std::is_enum_v<D>, "magic_enum::ops::operator<< requires enum type.");
+      const auto name = detail::name_impl<D>(static_cast<int>(value));
+
+      if (!name.empty()) {
+        os << name;
+      }
+
+      return os;
+    }
+
+    template <typename E, typename = detail::enable_if_enum_t<E>>
+    std::ostream& operator<<(std::ostream& os, std::optional<E> value) {
+      static_assert(std::is_enum_v<E>, "magic_enum::ops::operator<< requires enum type.");
+
+      if (value.has_value()) {
+        const auto name = detail::name_impl<E>(static_cast<int>(value.value()));
+        if (!name.empty()) {
+          os << name;
+        }
+      }
+
+      return os;
+    }
+
+  } // namespace magic_enum::ops
+
+} // namespace magic_enum
+
+namespace pprint {
+
+  // Specialise for an enum type to control how its values are named. Every
+  // member is optional; without a specialisation names are looked up in
+  // magic_enum::enum_range<E> (MAGIC_ENUM_RANGE_MIN..MAGIC_ENUM_RANGE_MAX),
+  // which costs one template instantiation per value in that range.
+  //
+  //   // Dense: only look names up in [min, max]
+  //   template <> struct pprint::enum_traits<Level> {
+  //     static constexpr int min = 0;
+  //     static constexpr int max = 2;
+  //   };
+  //
+  //   // Bit flags: name each set bit, printed as Read|Write
+  //   template <> struct pprint::enum_traits<Permission> {
+  //     static constexpr bool flags = true;
+  //   };
+  //
+  //   // Sparse: only these values have names
+  //   template <> struct pprint::enum_traits<Status> {
+  //     static constexpr Status values[] = {Status::ok, Status::not_found, Status::error};
+  //   };
+  template <typename E>
+  struct enum_traits {};
+
+  template <typename E, typename = void>
+  struct is_flag_enum : std::false_type {};
+
+  template <typename E>
+  struct is_flag_enum<E, to_void<decltype(enum_traits<E>::flags)>>
+    : std::bool_constant<enum_traits<E>::flags> {};
+
+  template <typename E, typename = void>
+  struct is_sparse_enum : std::false_type {};
+
+  template <typename E>
+  struct is_sparse_enum<E, to_void<decltype(enum_traits<E>::values)>> : std::true_type {};
+
+  // Clamps a range bound to the values representable by the underlying type
+  template <typename E>
+  constexpr int clamp_enum_value(int value) {
+    using U = std::underlying_type_t<E>;
+    constexpr long long lowest = std::is_signed_v<U> ? static_cast<long long>((std::numeric_limits<U>::min)()) : 0;
+    constexpr unsigned long long highest = static_cast<unsigned long long>((std::numeric_limits<U>::max)());
+    if (value < lowest)
+      return static_cast<int>(lowest);
+    if (value > 0 && static_cast<unsigned long long>(value) > highest)
+      return static_cast<int>(highest);
+    return value;
+  }
+
+  template <typename E, typename = void>
+  struct enum_value_range {
+    static constexpr int min = clamp_enum_value<E>(magic_enum::enum_range<E>::min);
+    static constexpr int max = clamp_enum_value<E>(magic_enum::enum_range<E>::max);
+  };
+
+  template <typename E>
+  struct enum_value_range<E, to_void<decltype(enum_traits<E>::min), decltype(enum_traits<E>::max)>> {
+    static constexpr int min = clamp_enum_value<E>(enum_traits<E>::min);
+    static constexpr int max = clamp_enum_value<E>(enum_traits<E>::max);
+  };
+
+  // Names of the values of E, computed at compile time from whichever of the
+  // enum_traits<E> forms applies, and looked up without allocating
+  template <typename E>
+  struct enum_names {
+    using U = std::underlying_type_t<E>;
+    using Bits = std::make_unsigned_t<U>;
+
+    static constexpr int min = enum_value_range<E>::min;
+    static constexpr int max = enum_value_range<E>::max;
+    static_assert(max >= min, "pprint::enum_traits requires max >= min.");
+
+    // Name of value, or an empty view
+    static std::string_view name(E value) {
+      if constexpr (is_sparse_enum<E>::value) {
+        constexpr auto names = sparse(std::make_index_sequence<std::size(enum_traits<E>::values)>{});
+        for (std::size_t i = 0; i < names.size(); i++) {
+          if (enum_traits<E>::values[i] == value)
+            return names[i];
+        }
+        return {};
+      }
+      else if constexpr (is_flag_enum<E>::value) {
+        return value == static_cast<E>(0) ? magic_enum::detail::name_impl<E, static_cast<E>(0)>() : std::string_view{};
+      }
+      else {
+        // One table entry per value in [min, max]
+        constexpr auto names = dense(std::make_integer_sequence<int, max - min + 1>{});
+        const long long index = static_cast<long long>(static_cast<U>(value)) - min;
+        if (index < 0 || index >= static_cast<long long>(names.size()))
+          return {};
+        return names[static_cast<std::size_t>(index)];
+      }
+    }
+
+    // Name of the single bit at position bit of a flag enum, or an empty view
+    static std::string_view bit_name(std::size_t bit) {
+      constexpr auto names = bits(std::make_integer_sequence<int, std::numeric_limits<Bits>::digits>{});
+      return names[bit];
+    }
+
+  private:
+    template <int... I>
+    static constexpr std::array<std::string_view, sizeof...(I)> dense(std::integer_sequence<int, I...>) {
+      return {{magic_enum::detail::name_impl<E, static_cast<E>(min + I)>()...}};
+    }
+
+    template <std::size_t... I>
+    static constexpr std::array<std::string_view, sizeof...(I)> sparse(std::index_sequence<I...>) {
+      return {{magic_enum::detail::name_impl<E, enum_traits<E>::values[I]>()...}};
+    }
+
+    template <int... I>
+    static constexpr std::array<std::string_view, sizeof...(I)> bits(std::integer_sequence<int, I...>) {
+      return {{magic_enum::detail::name_impl<E, static_cast<E>(static_cast<Bits>(Bits{1} << I))>()...}};
+    }
+  };
+
+  // Enumerations are printed by name, or as their underlying value if the
+  // value (or one of its bits) has no name
+  template <>
+  struct category_printer<category::enumeration> {
+    template <typename T>
+    static void print(PrettyPrinter& printer, T value, size_t indent, std::string_view line_terminator,
+        size_t level) {
+      printer.write_indent(indent);
+      if (printer.format_ != OutputFormat::text) {
+        std::string_view name = enum_names<T>::name(value);
+        std::string flags;
+        if (name.empty() && named(value)) {
+          printer.render_to(flags, [&] { write_name(printer, value); });
+          name = flags;
+        }
+        write_enumerator(printer, name, +static_cast<std::underlying_type_t<T>>(value), level);
+      }
+      else if (!write_name(printer, value)) {
+        printer.write_formatted(+static_cast<std::underlying_type_t<T>>(value)); // + so char-sized enums print as numbers
+      }
+      printer.write(line_terminator);
+    }
+
+    // An enumerator in machine-readable output: its name (an identifier,
+    // written as text as it is) or, if name is empty, its number
+    template <typename Number>
+    static void write_enumerator(PrettyPrinter& printer, std::string_view name, Number number, size_t level) {
+      if (printer.format_ == OutputFormat::binary) {
+        printer.write_tag(CaptureTag::enumeration);
+        printer.begin_array(2);
+        printer.write_number(number);
+        printer.write_text(name, level);
+        printer.end_array(2);
+        return;
+      }
+      if (name.empty()) {
+        printer.write_number(number);
+        return;
+      }
+      const bool quoted = printer.format_ == OutputFormat::json || level > 0;
+      if (quoted)
+        printer.write('"');
+      printer.write(name);
+      if (quoted)
+        printer.write('"');
+    }
+
+    // Writes the name of value, or Name|Name for flag enums. Returns false,
+    // having written nothing, if value (or one of its bits) has no name.
+    template <typename T>
+    static bool write_name(PrettyPrinter& printer, T value) {
+      const std::string_view name = enum_names<T>::name(value);
+      if (!name.empty()) {
+        printer.write(name);
+        return true;
+      }
+      if constexpr (is_flag_enum<T>::value) {
+        if (!named(value))
+          return false;
+        typedef typename enum_names<T>::Bits Bits;
+        const Bits bits = static_cast<Bits>(value);
+        bool first = true;
+        for (std::size_t bit = 0; bit < std::numeric_limits<Bits>::digits; bit++) {
+          if (bits >> bit & 1) {
+            if (!first)
+              printer.write('|');
+            printer.write(enum_names<T>::bit_name(bit));
+            first = false;
+          }
+        }
+        return true;
+      }
+      return false;
+    }
+
+    // Whether value has a name, or is a flag enum all of whose bits have one
+    template <typename T>
+    static bool named(T value) {
+      if (!enum_names<T>::name(value).empty())
+        return true;
+      if constexpr (is_flag_enum<T>::value) {
+        typedef typename enum_names<T>::Bits Bits;
+        const Bits bits = static_cast<Bits>(value);
+        if (bits == 0)
+          return false;
+        for (std::size_t bit = 0; bit < std::numeric_limits<Bits>::digits; bit++) {
+          if ((bits >> bit & 1) && enum_names<T>::bit_name(bit).empty())
+            return false;
+        }
+        return true;
+      }
+      return false;
+    }
+  };
+
+}
@@ -0,0 +1,100 @@
+// pprint/escape.hpp: finding the bytes of quoted strings to escape, with SIMD
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+// Quoted strings are scanned for bytes to escape with AVX2 or SSE2 when
+// the target has them. Define PPRINT_SIMD=0 to use the portable loop only.
+#if !defined(PPRINT_SIMD)
+#  define PPRINT_SIMD 1
+#endif
+#if PPRINT_SIMD && defined(__AVX2__)
+#  define PPRINT_AVX2 1
+#else
+#  define PPRINT_AVX2 0
+#endif
+#if PPRINT_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define PPRINT_SSE2 1
+#else
+#  define PPRINT_SSE2 0
+#endif
+#if PPRINT_AVX2
+#include <immintrin.h>
+#elif PPRINT_SSE2
+#include <emmintrin.h>
+#endif
+#if PPRINT_SSE2 && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace pprint {
+
+#if PPRINT_SSE2
+  inline unsigned lowest_bit(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+  }
+#endif
+
+  // Number of leading bytes of value that can be written between quote
+  // characters as they are: anything but the quote, a backslash, control
+  // characters and non-ASCII bytes (which need to be checked for valid
+  // UTF-8). Checks 32 or 16 bytes at a time where AVX2 or SSE2 is available.
+  inline size_t plain_prefix(std::string_view value, char quote) {
+    const char * data = value.data();
+    const size_t size = value.size();
+    size_t i = 0;
+#if PPRINT_AVX2
+    {
+      const __m256i quotes = _mm256_set1_epi8(quote);
+      const __m256i backslashes = _mm256_set1_epi8('\\');
+      const __m256i spaces = _mm256_set1_epi8(' ');
+      const __m256i deletes = _mm256_set1_epi8(0x7f);
+      for (; i + 32 <= size; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        // Bytes of 0x80 and above are negative, so "less than a space" also
+        // catches non-ASCII bytes
+        const __m256i special = _mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quotes), _mm256_cmpeq_epi8(bytes, backslashes)),
+          _mm256_or_si256(_mm256_cmpgt_epi8(spaces, bytes), _mm256_cmpeq_epi8(bytes, deletes)));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+        if (mask != 0)
+          return i + lowest_bit(mask);
+      }
+    }
+#endif
+#if PPRINT_SSE2
+    {
+      const __m128i quotes = _mm_set1_epi8(quote);
+      const __m128i backslashes = _mm_set1_epi8('\\');
+      const __m128i spaces = _mm_set1_epi8(' ');
+      const __m128i deletes = _mm_set1_epi8(0x7f);
+      for (; i + 16 <= size; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i special = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(bytes, quotes), _mm_cmpeq_epi8(bytes, backslashes)),
+          _mm_or_si128(_mm_cmplt_epi8(bytes, spaces), _mm_cmpeq_epi8(bytes, deletes)));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+        if (mask != 0)
+          return i + lowest_bit(mask);
+      }
+    }
+#endif
+    for (; i < size; i++) {
+      const unsigned char byte = static_cast<unsigned char>(data[i]);
+      if (data[i] == quote || byte == '\\' || byte < 0x20 || byte >= 0x7f)
+        return i;
+    }
+    return size;
+  }
+
+}
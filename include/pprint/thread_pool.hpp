@@ -0,0 +1,131 @@
+// pprint/thread_pool.hpp: the worker threads of parallel printing
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace pprint {
+
+  // Worker threads for parallel printing. run(tasks, task) calls task(0)
+  // ... task(tasks - 1) on the workers and the calling thread, returns when
+  // all of them have finished and rethrows the first exception thrown.
+  class ThreadPool {
+  public:
+    explicit ThreadPool(size_t threads) {
+      for (size_t i = 0; i < threads; i++)
+        workers_.emplace_back([this] { work(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+      }
+      wake_.notify_all();
+      for (auto& worker : workers_)
+        worker.join();
+    }
+
+    // Used by parallel printers, started on first use with a worker per
+    // hardware thread besides the caller (at least one)
+    static ThreadPool& shared() {
+      static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+      return pool;
+    }
+
+    // Threads taking part in a run, the caller included
+    size_t size() const {
+      return workers_.size() + 1;
+    }
+
+    template <typename Task>
+    void run(size_t tasks, Task&& task) {
+      Job job;
+      job.call = [](void * context, size_t index) { (*static_cast<std::remove_reference_t<Task>*>(context))(index); };
+      job.context = &task;
+      job.tasks = tasks;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(&job);
+      }
+      wake_.notify_all();
+      execute(job);
+      std::unique_lock<std::mutex> lock(mutex_);
+      // Once the job is off the queue, no worker can pick it up again
+      auto queued = std::find(jobs_.begin(), jobs_.end(), &job);
+      if (queued != jobs_.end())
+        jobs_.erase(queued);
+      done_.wait(lock, [&job] { return job.workers == 0; });
+      if (job.error)
+        std::rethrow_exception(job.error);
+    }
+
+  private:
+    struct Job {
+      void (*call)(void *, size_t);
+      void * context;
+      size_t tasks;
+      std::atomic<size_t> next {0};
+      size_t workers = 0;         // workers running tasks, guarded by mutex_
+      std::exception_ptr error;   // guarded by mutex_
+    };
+
+    void execute(Job& job) {
+      for (;;) {
+        const size_t index = job.next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= job.tasks)
+          return;
+        try {
+          job.call(job.context, index);
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (!job.error)
+            job.error = std::current_exception();
+        }
+      }
+    }
+
+    void work() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      for (;;) {
+        wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty())
+          return;
+        Job& job = *jobs_.front();
+        if (job.next.load(std::memory_order_relaxed) >= job.tasks) {
+          jobs_.pop_front();
+          continue;
+        }
+        job.workers += 1;
+        lock.unlock();
+        execute(job);
+        lock.lock();
+        if (--job.workers == 0)
+          done_.notify_all();
+      }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::deque<Job*> jobs_;
+    bool stopping_ = false;
+  };
+
+}
@@ -0,0 +1,75 @@
+// pprint/utility.hpp: std::variant and std::complex
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "core.hpp"
+#include <variant>
+#include <complex>
+
+namespace pprint {
+
+  // Variants are printed as the alternative they hold; binary output
+  // keeps its index too
+  template <>
+  struct category_printer<category::variant> {
+    template <typename Variant>
+    static void print(PrettyPrinter& printer, const Variant& value, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      std::visit([&](const auto& alternative) {
+        print_alternative(printer, value.index(), alternative, indent, line_terminator, level);
+      }, value);
+    }
+
+    template <typename T>
+    static void print_alternative(PrettyPrinter& printer, size_t index, const T& alternative, size_t indent,
+        std::string_view line_terminator, size_t level) {
+      if (printer.format_ != OutputFormat::binary) {
+        printer.print_internal(alternative, indent, line_terminator, level);
+        return;
+      }
+      printer.write_tag(CaptureTag::variant);
+      printer.begin_array(2);
+      printer.write_number(index);
+      printer.print_internal(alternative, 0, "", level);
+      printer.end_array(2);
+      printer.write(line_terminator);
+    }
+  };
+
+  // Complex numbers are (1 + 2i), or {"real":1,"imag":2} in JSON
+  template <>
+  struct category_printer<category::complex> {
+    template <typename T>
+    static void print(PrettyPrinter& printer, const std::complex<T>& value, size_t indent,
+        std::string_view line_terminator, size_t) {
+      printer.write_indent(indent);
+      if (printer.format_ == OutputFormat::binary) {
+        printer.write_tag(CaptureTag::complex);
+        printer.begin_array(2);
+        printer.write_number(value.real());
+        printer.write_number(value.imag());
+        printer.end_array(2);
+        printer.write(line_terminator);
+        return;
+      }
+      if (printer.format_ != OutputFormat::text) {
+        printer.write("{\"real\":");
+        printer.write_real(value.real());
+        printer.write(",\"imag\":");
+        printer.write_real(value.imag());
+        printer.write('}');
+        printer.write(line_terminator);
+        return;
+      }
+      printer.write('(');
+      printer.write_number(value.real());
+      printer.write(" + ");
+      printer.write_number(value.imag());
+      printer.write("i)");
+      printer.write(line_terminator);
+    }
+  };
+
+}
@@ -0,0 +1,61 @@
+// pprint as a C++20 module:
+//
+//   import pprint;
+//
+// Built by the pprint::module CMake target (-DPPRINT_BUILD_MODULE=ON).
+// Macros such as PPRINT_SIMD or MAGIC_ENUM_RANGE_MAX do not cross a module
+// boundary: set them as compile definitions of that target instead.
+module;
+
+#include <pprint.hpp>
+
+export module pprint;
+
+export namespace pprint {
+  using pprint::PrettyPrinter;
+  using pprint::AsyncSink;
+  using pprint::OverflowPolicy;
+  using pprint::ThreadPool;
+  using pprint::FloatFormat;
+  using pprint::OutputFormat;
+  using pprint::CaptureTag;
+  using pprint::CapturedValue;
+  using pprint::CapturedRecord;
+  using pprint::CaptureReader;
+  using pprint::render;
+  using pprint::Measurement;
+  using pprint::Range;
+  using pprint::range;
+  using pprint::unknown_size;
+  using pprint::pformat;
+  using pprint::format_to;
+  using pprint::type_name;
+  using pprint::is_deferrable;
+  using pprint::enum_traits;
+  using pprint::category_of;
+  using pprint::category_printer;
+
+  namespace category {
+    using pprint::category::sequence;
+    using pprint::category::smart_pointer;
+    using pprint::category::streamable;
+    using pprint::category::range;
+    using pprint::category::object;
+    using pprint::category::enumeration;
+    using pprint::category::set;
+    using pprint::category::map;
+    using pprint::category::queue;
+    using pprint::category::priority_queue;
+    using pprint::category::stack;
+    using pprint::category::variant;
+    using pprint::category::complex;
+    using pprint::category::captured;
+  }
+}
+
+export namespace magic_enum {
+  using magic_enum::enum_range;
+}
+
+// std::tuple operator<<
+export using ::operator<<;
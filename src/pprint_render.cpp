@@ -0,0 +1,88 @@
+// pprint-render: prints captures written with OutputFormat::binary
+//
+// Part of pprint, Pretty Printer for Modern C++: https://github.com/p-ranav/pprint
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+#include <pprint.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+static void usage(const char * program) {
+  std::printf("usage: %s [--format text|json|logfmt] [--compact] [--quotes] [--width N] [--indent N]\n"
+              "       [--max-items N] [--max-depth N] [--max-string-length N] [FILE...]\n", program);
+}
+
+static bool read_file(std::istream& input, std::string& capture) {
+  capture.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  return !input.bad();
+}
+
+int main(int argc, char * argv[]) {
+  std::ios_base::sync_with_stdio(false);
+  pprint::PrettyPrinter printer(std::cout);
+  std::vector<const char *> files;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+      const char * format = argv[++i];
+      if (std::strcmp(format, "text") == 0)
+        printer.output_format(pprint::OutputFormat::text);
+      else if (std::strcmp(format, "json") == 0)
+        printer.output_format(pprint::OutputFormat::json);
+      else if (std::strcmp(format, "logfmt") == 0)
+        printer.output_format(pprint::OutputFormat::logfmt);
+      else {
+        usage(argv[0]);
+        return 1;
+      }
+    }
+    else if (std::strcmp(argv[i], "--compact") == 0)
+      printer.compact(true);
+    else if (std::strcmp(argv[i], "--quotes") == 0)
+      printer.quotes(true);
+    else if (std::strcmp(argv[i], "--width") == 0 && i + 1 < argc)
+      printer.width(std::strtoull(argv[++i], nullptr, 10));
+    else if (std::strcmp(argv[i], "--indent") == 0 && i + 1 < argc)
+      printer.indent(std::strtoull(argv[++i], nullptr, 10));
+    else if (std::strcmp(argv[i], "--max-items") == 0 && i + 1 < argc)
+      printer.max_items(std::strtoull(argv[++i], nullptr, 10));
+    else if (std::strcmp(argv[i], "--max-depth") == 0 && i + 1 < argc)
+      printer.max_depth(std::strtoull(argv[++i], nullptr, 10));
+    else if (std::strcmp(argv[i], "--max-string-length") == 0 && i + 1 < argc)
+      printer.max_string_length(std::strtoull(argv[++i], nullptr, 10));
+    else if (argv[i][0] != '-' || std::strcmp(argv[i], "-") == 0)
+      files.push_back(argv[i]);
+    else {
+      usage(argv[0]);
+      return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+  if (files.empty())
+    files.push_back("-");
+
+  std::string capture;
+  for (const char * file : files) {
+    bool read;
+    if (std::strcmp(file, "-") == 0) {
+      read = read_file(std::cin, capture);
+    }
+    else {
+      std::ifstream input(file, std::ios::binary);
+      read = input && read_file(input, capture);
+    }
+    if (!read) {
+      std::fprintf(stderr, "%s: cannot read %s\n", argv[0], file);
+      return 1;
+    }
+    try {
+      pprint::render(capture, printer);
+    }
+    catch (const std::runtime_error& error) {
+      printer.flush();
+      std::cout.flush();
+      std::fprintf(stderr, "%s: %s: %s\n", argv[0], file, error.what());
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,7 @@
+// Explicit instantiations of the printer for the types in
+// PPRINT_STATIC_TYPES, compiled into pprint::pprint_static
+#include <pprint.hpp>
+
+#define PPRINT_STATIC_TYPE(...) \
+  template void pprint::PrettyPrinter::print_value(const __VA_ARGS__&, std::size_t, std::string_view);
+#include <pprint_static_types.hpp>
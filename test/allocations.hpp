@@ -0,0 +1,15 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Number of heap allocations made so far by the test binary, counted by
+// the operator new of main.cpp
+extern std::atomic<std::size_t> allocation_count;
+
+// Heap allocations made by print()
+template <typename F>
+std::size_t allocations_of(F&& print) {
+  const std::size_t before = allocation_count.load(std::memory_order_relaxed);
+  print();
+  return allocation_count.load(std::memory_order_relaxed) - before;
+}
@@ -4,3 +4,45 @@
 #include "test_unordered_set.hpp"
 #include "test_set.hpp"
 #include "test_vector.hpp"
+#include "test_output.hpp"
+#include "test_arguments.hpp"
+#include "test_adaptor.hpp"
+#include "test_enum.hpp"
+#include "test_number.hpp"
+#include "test_limits.hpp"
+#include "test_range.hpp"
+#include "test_thread.hpp"
+#include "test_sink.hpp"
+#include "test_deferred.hpp"
+#include "test_parallel.hpp"
+#include "test_escape.hpp"
+#include "test_width.hpp"
+#include "test_measure.hpp"
+#include "test_format.hpp"
+#include "test_output_format.hpp"
+#include "test_capture.hpp"
+#include <cstdlib>
+#include <new>
+
+std::atomic<std::size_t> allocation_count {0};
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+// operator new below is malloc-backed, so free() is the matching release
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Count every heap allocation, for the tests of allocation-free printing
+void * operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void * ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
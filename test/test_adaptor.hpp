@@ -0,0 +1,93 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("Print queue front to back",
+	  "[std::queue]") {
+  std::queue<int> foo;
+  for (int n : {3, 1, 2})
+    foo.push(n);
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(foo);
+
+  REQUIRE(stream.str() == "[3, 1, 2]\n");
+  REQUIRE(foo.size() == 3);
+}
+
+TEST_CASE("Print stack top to bottom",
+	  "[std::stack]") {
+  std::stack<int> foo;
+  for (int n : {1, 2, 3})
+    foo.push(n);
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(foo);
+
+  const std::string expected = "[\n"
+    "  3, \n"
+    "  2, \n"
+    "  1"
+    "\n]\n";
+
+  REQUIRE(stream.str() == expected);
+  REQUIRE(foo.top() == 3);
+}
+
+TEST_CASE("Print priority_queue in pop order",
+	  "[std::priority_queue]") {
+  std::priority_queue<int> foo;
+  std::priority_queue<int, std::vector<int>, std::greater<int>> bar;
+  for (int n : {1, 8, 5, 6, 3, 4, 0, 9, 7, 2}) {
+    foo.push(n);
+    bar.push(n);
+  }
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(foo);
+  printer.print(bar);
+
+  REQUIRE(stream.str() == "[9, 8, 7, 6, 5, 4, 3, 2, 1, 0]\n"
+    "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9]\n");
+  REQUIRE(foo.size() == 10);
+}
+
+TEST_CASE("Print priority_queue in heap order",
+	  "[std::priority_queue]") {
+  std::vector<int> heap {1, 8, 5, 6, 3};
+  std::make_heap(heap.begin(), heap.end());
+  std::priority_queue<int> foo(std::less<int>(), heap);
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.heap_order(true);
+  printer.print(foo);
+
+  pprint::PrettyPrinter reference(stream);
+  reference.compact(true);
+  reference.print(heap);
+
+  const std::string output = stream.str();
+  REQUIRE(output.substr(0, output.size() / 2) == output.substr(output.size() / 2));
+}
+
+TEST_CASE("Print adaptors of move-only values",
+	  "[std::queue]") {
+  std::queue<std::unique_ptr<int>> foo;
+  foo.push(std::make_unique<int>(1));
+  std::stack<std::unique_ptr<int>> bar;
+  bar.push(std::make_unique<int>(2));
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(foo);
+  printer.print(bar);
+
+  const std::string output = stream.str();
+  REQUIRE(output.substr(0, 2) == "[<");
+  REQUIRE(output.substr(output.size() - 3) == ">]\n");
+}
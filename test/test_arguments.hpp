@@ -0,0 +1,60 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+namespace {
+  // Counts how many times it has been copied
+  struct CopyCounter {
+    static size_t copies;
+    CopyCounter() = default;
+    CopyCounter(const CopyCounter&) { copies += 1; }
+    friend std::ostream& operator<<(std::ostream& os, const CopyCounter&) {
+      return os << "counter";
+    }
+  };
+  size_t CopyCounter::copies = 0;
+}
+
+TEST_CASE("Printing does not copy the printed value",
+	  "[arguments]") {
+  CopyCounter::copies = 0;
+  std::vector<CopyCounter> foo(3);
+  std::map<int, CopyCounter> bar {{1, {}}};
+  std::pair<int, CopyCounter> baz {std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple()};
+  std::optional<CopyCounter> qux {std::in_place};
+  std::variant<int, CopyCounter> quux {std::in_place_index<1>};
+  CopyCounter::copies = 0;
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(foo);
+  printer.print(bar);
+  printer.print(CopyCounter{}, baz);
+  printer.print(qux);
+  printer.print(quux);
+
+  REQUIRE(CopyCounter::copies == 0);
+  REQUIRE(stream.str() == "[counter, counter, counter]\n"
+    "{1 : counter}\n"
+    "counter (1, counter)\n"
+    "counter\n"
+    "counter\n");
+}
+
+TEST_CASE("Print a vector of move-only values",
+	  "[arguments]") {
+  std::vector<std::unique_ptr<int>> foo;
+  foo.push_back(std::make_unique<int>(1));
+  foo.push_back(nullptr);
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(foo);
+
+  const std::string output = stream.str();
+  REQUIRE(output.substr(0, 2) == "[<");
+  REQUIRE(output.substr(output.size() - 3) == ">]\n");
+}
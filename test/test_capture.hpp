@@ -0,0 +1,137 @@
+#pragma once
+#include <pprint.hpp>
+#include <forward_list>
+
+#include "catch2/catch.hpp"
+
+namespace capture_test {
+
+  enum class Level { info, warning };
+
+  struct Point {
+    int x, y;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Point& value) {
+    return os << "Point(" << value.x << ", " << value.y << ")";
+  }
+
+  inline void configure(pprint::PrettyPrinter& printer, pprint::OutputFormat format, bool compact, size_t width) {
+    printer.output_format(format).compact(compact).quotes(compact).width(width);
+  }
+
+  // Checks that rendering the capture of print and print_inline(values...)
+  // writes what printing them does, in every output format
+  template <typename... Args>
+  void check(bool compact, size_t width, const Args&... values) {
+    for (auto format : {pprint::OutputFormat::text, pprint::OutputFormat::json, pprint::OutputFormat::logfmt}) {
+      std::stringstream direct_stream, capture_stream, rendered_stream;
+      pprint::PrettyPrinter direct(direct_stream), capture(capture_stream), rendered(rendered_stream);
+      configure(direct, format, compact, width);
+      configure(capture, pprint::OutputFormat::binary, compact, width);
+      configure(rendered, format, compact, width);
+      direct.print(values...);
+      direct.print_inline(values...);
+      capture.print(values...);
+      capture.print_inline(values...);
+      pprint::render(capture_stream.str(), rendered);
+      REQUIRE(rendered_stream.str() == direct_stream.str());
+    }
+  }
+
+}
+
+TEST_CASE("Rendered captures match the printed output",
+	  "[capture]") {
+  using namespace capture_test;
+  std::queue<int> queue;
+  queue.push(1);
+  queue.push(2);
+  std::stack<std::string> stack;
+  stack.push("top");
+  const auto pointer = std::make_unique<std::map<std::string, int>>(std::map<std::string, int> {{"a", 1}});
+  for (bool compact : {false, true}) {
+    for (size_t width : {size_t(0), size_t(20)}) {
+      check(compact, width, std::map<std::string, std::vector<int>> {{"a", {1, 2}}, {"b", {}}});
+      check(compact, width, -2, 3u, 2.5, 0.1f, 'c', "text", true, nullptr, std::optional<int> {}, std::optional<int> {4});
+      check(compact, width, std::make_tuple(1, 'x', std::string("s"), 2.5f, true, Point {1, 2}));
+      check(compact, width, Level::warning, static_cast<Level>(5), std::vector<Level> {Level::info});
+      check(compact, width, std::variant<int, std::string> {"v"}, std::complex<double>(1, -2), std::complex<float>(3, 4));
+      check(compact, width, std::set<int> {1, 2}, std::set<std::vector<int>> {{1}, {2, 3}}, queue, stack);
+      check(compact, width, Point {3, 4}, std::make_pair(1, std::string("v")), std::map<int, std::map<int, int>> {{1, {{2, 3}}}});
+      check(compact, width, std::unique_ptr<int>(), std::make_shared<std::vector<int>>(3, 1), pointer);
+      check(compact, width, std::numeric_limits<long long>::min(), std::numeric_limits<unsigned long long>::max(), 1e300);
+      check(compact, width, std::string("\xff\xfe"), std::string("caf\xc3\xa9"), '\xe9', std::string("\xed\xa0\x80"));
+      check(compact, width, -0.0, 1.5f, 65504.0, std::ldexp(1.0, -24), std::ldexp(3.0, -149), 1e-310, 0.1,
+        std::numeric_limits<double>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<float>::max());
+    }
+  }
+}
+
+TEST_CASE("Rendered captures of ranges of unknown size elide as printing does",
+	  "[capture]") {
+  using namespace capture_test;
+  const std::forward_list<int> list {1, 2, 3};
+  for (auto format : {pprint::OutputFormat::text, pprint::OutputFormat::json, pprint::OutputFormat::logfmt}) {
+    std::stringstream direct_stream, capture_stream, rendered_stream;
+    pprint::PrettyPrinter direct(direct_stream), capture(capture_stream), rendered(rendered_stream);
+    direct.output_format(format).max_items(2);
+    capture.output_format(pprint::OutputFormat::binary);
+    rendered.output_format(format).max_items(2);
+    direct.print(list);
+    capture.print(list);
+    pprint::render(capture_stream.str(), rendered);
+    REQUIRE(rendered_stream.str() == direct_stream.str());
+  }
+}
+
+TEST_CASE("Captures are compact CBOR that text settings do not change",
+	  "[capture]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.output_format(pprint::OutputFormat::binary).max_items(1).max_string_length(1).width(4);
+  printer.print(1, "ab", std::vector<int> {-1, 2});
+  REQUIRE(stream.str() == std::string("\x83\x01\x62" "ab" "\x82\x20\x02", 8));
+}
+
+TEST_CASE("Captures write numbers in their shortest exact encoding",
+	  "[capture]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.output_format(pprint::OutputFormat::binary);
+  // Half, single and double precision, a tagged float and a 32-bit integer
+  printer.print(-2.5, 100000.5, 0.1, 0.5f, 1000000);
+  REQUIRE(stream.str() == std::string("\x85" "\xf9\xc1\x00" "\xfa\x47\xc3\x50\x40"
+    "\xfb\x3f\xb9\x99\x99\x99\x99\x99\x9a" "\xd9\x70\x7d\xf9\x38\x00" "\x1a\x00\x0f\x42\x40", 29));
+}
+
+TEST_CASE("Captures write text that is not UTF-8 as byte strings",
+	  "[capture]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.output_format(pprint::OutputFormat::binary);
+  printer.print(std::string("\xc3\xa9"), std::string("\xc3"), std::string("a\xff"));
+  REQUIRE(stream.str() == std::string("\x83" "\x62\xc3\xa9" "\x41\xc3" "\x42" "a\xff", 9));
+}
+
+TEST_CASE("Rendering applies the settings of the printer",
+	  "[capture]") {
+  std::stringstream capture_stream, stream;
+  pprint::PrettyPrinter capture(capture_stream), printer(stream);
+  capture.output_format(pprint::OutputFormat::binary);
+  capture.print(std::vector<std::string> {"one", "two", "three"});
+  printer.compact(true).quotes(true).max_items(2).max_string_length(2);
+  pprint::render(capture_stream.str(), printer);
+  REQUIRE(stream.str() == "[\"on...\", \"tw...\", ... 1 more]\n");
+}
+
+TEST_CASE("Malformed captures throw",
+	  "[capture]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  // A cut array, a cut string, a record that is not an array and a character of two bytes
+  for (std::string capture : {"\x82\x01", "\x81\x65" "ab", "\x01", "\x81\xd9\x70\x71\x62" "ab"})
+    REQUIRE_THROWS_AS(pprint::render(capture, printer), std::runtime_error);
+  REQUIRE_THROWS_AS(pprint::render(std::string(100000, '\x81'), printer), std::runtime_error);
+}
@@ -0,0 +1,42 @@
+// Compiled on its own with only pprint/core.hpp, to check that types get
+// the same category as in the tests that include <pprint.hpp>
+#include <pprint/core.hpp>
+#include <list>
+#include <deque>
+#include <array>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <queue>
+#include <stack>
+#include <complex>
+#include <sstream>
+
+#include "catch2/catch.hpp"
+
+template <typename T, typename Category>
+constexpr bool has_category = std::is_same_v<typename pprint::category_of<T>::type, Category>;
+
+static_assert(has_category<std::list<int>, pprint::category::sequence>);
+static_assert(has_category<std::deque<int>, pprint::category::sequence>);
+static_assert(has_category<std::array<int, 2>, pprint::category::sequence>);
+static_assert(has_category<std::set<int>, pprint::category::set>);
+static_assert(has_category<std::multiset<int>, pprint::category::set>);
+static_assert(has_category<std::map<int, int>, pprint::category::map>);
+static_assert(has_category<std::unordered_map<int, int>, pprint::category::map>);
+static_assert(has_category<std::queue<int>, pprint::category::queue>);
+static_assert(has_category<std::priority_queue<int>, pprint::category::priority_queue>);
+static_assert(has_category<std::stack<int>, pprint::category::stack>);
+static_assert(has_category<std::variant<int, double>, pprint::category::variant>);
+static_assert(has_category<std::complex<double>, pprint::category::complex>);
+
+TEST_CASE("Sequences print the same without the family headers",
+	  "[core]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true).max_items(2);
+  printer.print(std::list<int> {1, 2, 3});
+  printer.print(std::deque<int> {4});
+  printer.print(std::array<int, 2> {5, 6});
+  REQUIRE(stream.str() == "[1, 2, ... 1 more]\n[4]\n[5, 6]\n");
+}
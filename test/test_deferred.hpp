@@ -0,0 +1,192 @@
+#pragma once
+#include <pprint.hpp>
+#include <thread>
+#include <forward_list>
+#include <sstream>
+
+#include "catch2/catch.hpp"
+
+namespace deferred_test {
+
+  struct Point {
+    int x, y;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Point& point) {
+    return os << "Point(" << point.x << ", " << point.y << ")";
+  }
+
+  // A type without a flat form, kept as a copy
+  struct Name {
+    std::string value;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Name& name) {
+    return os << "Name(" << name.value << ")";
+  }
+
+  // Prints with an immediate and with a deferred printer, returns both outputs
+  template <typename F>
+  std::pair<std::string, std::string> both(bool compact, F&& print) {
+    std::stringstream immediate, deferred;
+    {
+      pprint::PrettyPrinter printer(immediate);
+      printer.compact(compact).quotes(true);
+      print(printer);
+    }
+    {
+      pprint::PrettyPrinter printer(deferred);
+      printer.compact(compact).quotes(true).deferred(true);
+      print(printer);
+    }
+    return {immediate.str(), deferred.str()};
+  }
+
+}
+
+TEST_CASE("Deferred printing matches immediate printing",
+	  "[deferred]") {
+  using namespace deferred_test;
+  for (bool compact : {true, false}) {
+    auto outputs = both(compact, [](pprint::PrettyPrinter& printer) {
+      const char text[] = "array";
+      int numbers[] = {1, 2, 3};
+      std::string_view view = "view";
+      printer.print(std::map<std::string, std::vector<int>> {{"a", {1, 2}}, {"b", {}}});
+      printer.print(std::vector<std::string> {"x", "y"}, 3.5, 'c', text, view);
+      printer.print(std::set<std::vector<bool>> {{true, false}, {false}});
+      printer.print(numbers, std::array<std::string, 2> {"p", "q"});
+      printer.print(Point {1, 2}, std::vector<Point> {{3, 4}}, Name {"n"});
+      printer.print(std::vector<Name> {{"a"}, {"b"}});
+      printer.print_inline(std::deque<int> {4, 5}, nullptr, "inline");
+      printer.print({1, 2, 3});
+      printer.print({Name {"list"}});
+    });
+    REQUIRE(outputs.first == outputs.second);
+  }
+}
+
+TEST_CASE("Deferred printing writes nothing before flush",
+	  "[deferred]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.deferred(true);
+  std::string value = "before";
+  printer.print(value);
+  value = "after";
+  printer.print(std::vector<int> {1});
+  REQUIRE(stream.str() == "");
+  printer.flush();
+  REQUIRE(stream.str() == "before\n[1]\n");
+  printer.print(value);
+  printer.flush();
+  REQUIRE(stream.str() == "before\n[1]\nafter\n");
+}
+
+TEST_CASE("Deferred printing prints what it cannot copy in order",
+	  "[deferred]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.deferred(true);
+  std::vector<std::unique_ptr<int>> pointers;
+  printer.print("first");
+  printer.print(pointers);
+  REQUIRE(stream.str() == "first\n[]\n");
+}
+
+TEST_CASE("Values holding what cannot be copied are printed right away",
+	  "[deferred]") {
+  std::stringstream stream, expected;
+  pprint::PrettyPrinter printer(expected), deferred(stream);
+  deferred.deferred(true);
+  std::pair<int, std::vector<std::unique_ptr<int>>> pair;
+  std::optional<std::vector<std::unique_ptr<int>>> optional;
+  std::tuple<int, std::vector<std::unique_ptr<int>>> tuple;
+  printer.print("first");
+  printer.print(pair, optional, tuple);
+  printer.print("last");
+  deferred.print("first");
+  deferred.print(pair, optional, tuple);
+  REQUIRE(stream.str() == expected.str().substr(0, expected.str().size() - 5));
+  deferred.print("last");
+  deferred.flush();
+  REQUIRE(stream.str() == expected.str());
+}
+
+TEST_CASE("Deferred printing copies what views refer to",
+	  "[deferred]") {
+  for (bool compact : {true, false}) {
+    std::stringstream expected, stream;
+    pprint::PrettyPrinter printer(expected), deferred(stream);
+    printer.compact(compact).max_items(2);
+    deferred.compact(compact).max_items(2).deferred(true);
+    {
+      std::vector<int> vector {1, 2, 3};
+      std::string text = "a string too long for the small string buffer";
+      int numbers[3] = {4, 5, 6};
+      std::forward_list<int> list {7, 8, 9};
+      std::istringstream in("10 11 12"), in_copy("10 11 12");
+      const auto print = [&](pprint::PrettyPrinter& to, std::istream& input) {
+        to.print(pprint::range(vector), pprint::range(vector.begin(), vector.begin() + 2));
+        to.print(std::make_pair(1, std::string_view(text)), std::optional<const char *>(text.c_str()));
+        to.print(std::make_tuple(std::string_view(text), text, 'c', "literal"), std::tie(numbers[0], text));
+        to.print(numbers, std::variant<int, std::string_view, int>(std::in_place_index<1>, text));
+        to.print(std::vector<std::pair<int, std::string_view>> {{1, text}}, list);
+        to.print(pprint::range(std::istream_iterator<int>(input), std::istream_iterator<int>()));
+      };
+      print(printer, in);
+      print(deferred, in_copy);
+      vector.assign(100, 0);
+      text.assign(100, 'x');
+      numbers[0] = 0;
+      list.clear();
+    }
+    REQUIRE(stream.str() == "");
+    deferred.flush();
+    REQUIRE(stream.str() == expected.str());
+  }
+}
+
+TEST_CASE("Arrays are printed like std::array",
+	  "[deferred]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  int numbers[3] = {1, 2, 3};
+  const std::string strings[2] = {"a", "b"};
+  printer.print(numbers);
+  printer.print(strings);
+  REQUIRE(stream.str() == "[1, 2, 3]\n[a, b]\n");
+}
+
+TEST_CASE("Detached records are formatted on another thread",
+	  "[deferred]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.deferred(true).compact(true);
+  for (int i = 0; i < 100; i++)
+    printer.print("record", i, std::vector<int> {i, i + 1});
+
+  pprint::PrettyPrinter records = printer.detach();
+  printer.print("next");
+  std::thread([records = std::move(records)]() mutable { records.flush(); }).join();
+  const std::string output = stream.str();
+  REQUIRE(output.substr(0, 19) == "record 0 [0, 1]\nrec");
+  REQUIRE(std::count(output.begin(), output.end(), '\n') == 100);
+  printer.flush();
+  REQUIRE(stream.str() == output + "next\n");
+}
+
+static_assert(pprint::is_deferrable<std::map<std::string, std::vector<int>>>::value);
+static_assert(!pprint::is_deferrable<std::unique_ptr<int>>::value);
+static_assert(!pprint::is_deferrable<std::pair<int, std::vector<std::unique_ptr<int>>>>::value);
+static_assert(!pprint::is_deferrable<std::tuple<int, std::unique_ptr<int>>>::value);
+static_assert(!pprint::is_deferrable<std::optional<std::vector<std::unique_ptr<int>>>>::value);
+static_assert(!pprint::is_deferrable<std::variant<int, std::unique_ptr<int>>>::value);
+static_assert(pprint::is_deferrable<std::pair<const std::string, std::variant<int, std::string>>>::value);
+static_assert(pprint::is_deferrable<std::pair<int, std::string_view>>::value);
+static_assert(!pprint::is_copy_safe<std::pair<int, std::string_view>>::value);
+static_assert(!pprint::is_copy_safe<std::tuple<int&>>::value);
+static_assert(!pprint::is_copy_safe<pprint::Range<std::vector<int>::const_iterator>>::value);
+static_assert(!pprint::is_deferrable<char *>::value);
+static_assert(!pprint::is_deferrable<std::vector<std::pair<std::string_view, std::unique_ptr<int>>>>::value);
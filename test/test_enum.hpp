@@ -0,0 +1,71 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+namespace test_enums {
+  enum Color { RED = 2, BLUE = 4, GREEN = 8 };
+  enum class Level : unsigned char { LOW, MEDIUM, HIGH };
+  enum class Permission : unsigned { None = 0, Read = 1, Write = 2, Execute = 4 };
+  enum class Status { ok = 0, not_found = 404, error = 5000 };
+  enum class Port { http = 8080, https = 8443 };
+}
+
+template <> struct pprint::enum_traits<test_enums::Level> {
+  static constexpr int min = 0;
+  static constexpr int max = 2;
+};
+
+template <> struct pprint::enum_traits<test_enums::Permission> {
+  static constexpr bool flags = true;
+};
+
+template <> struct pprint::enum_traits<test_enums::Status> {
+  static constexpr test_enums::Status values[] = {
+    test_enums::Status::ok, test_enums::Status::not_found, test_enums::Status::error};
+};
+
+template <> struct pprint::enum_traits<test_enums::Port> {
+  static constexpr int min = 8000;
+  static constexpr int max = 8500;
+};
+
+TEST_CASE("Print enum names in the default range",
+	  "[enum]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(test_enums::BLUE, test_enums::Color(3));
+
+  REQUIRE(stream.str() == "BLUE 3\n");
+}
+
+TEST_CASE("Print enum names in a registered range",
+	  "[enum]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(test_enums::Level::HIGH, test_enums::Level(7), test_enums::Port::https);
+
+  REQUIRE(stream.str() == "HIGH 7 https\n");
+}
+
+TEST_CASE("Print flag enums as their set bits",
+	  "[enum]") {
+  using test_enums::Permission;
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(std::vector<Permission>{Permission::None, Permission::Write, Permission(3),
+    Permission(7), Permission(9)});
+
+  REQUIRE(stream.str() == "[None, Write, Read|Write, Read|Write|Execute, 9]\n");
+}
+
+TEST_CASE("Print sparse enums",
+	  "[enum]") {
+  using test_enums::Status;
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(Status::ok, Status::not_found, Status::error, Status(3));
+
+  REQUIRE(stream.str() == "ok not_found error 3\n");
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+namespace escape_test {
+
+  inline std::string printed(std::string_view value) {
+    std::stringstream stream;
+    pprint::PrettyPrinter printer(stream);
+    printer.quotes(true);
+    printer.print(std::string(value));
+    return stream.str();
+  }
+
+}
+
+TEST_CASE("Quoted strings are escaped",
+	  "[escape]") {
+  using escape_test::printed;
+  REQUIRE(printed("say \"hi\"") == "\"say \\\"hi\\\"\"\n");
+  REQUIRE(printed("a\\b") == "\"a\\\\b\"\n");
+  REQUIRE(printed("one\ntwo\r\tthree") == "\"one\\ntwo\\r\\tthree\"\n");
+  REQUIRE(printed(std::string("\x1b[0m\x7f\0", 6)) == "\"\\x1b[0m\\x7f\\x00\"\n");
+  REQUIRE(printed("it's") == "\"it's\"\n");
+}
+
+TEST_CASE("Quoted strings keep valid UTF-8 and escape invalid bytes",
+	  "[escape]") {
+  using escape_test::printed;
+  REQUIRE(printed("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80") == "\"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\"\n");
+  REQUIRE(printed("bad \xff \xc3 \xe0\x80\x80 \xed\xa0\x80") ==
+    "\"bad \\xff \\xc3 \\xe0\\x80\\x80 \\xed\\xa0\\x80\"\n");
+  REQUIRE(printed("line\xe2\x80\xa8par\xe2\x80\xa9") == "\"line\\u2028par\\u2029\"\n");
+}
+
+TEST_CASE("Escapes are found at every offset of long strings",
+	  "[escape]") {
+  using escape_test::printed;
+  const std::pair<std::string, std::string> specials[] = {
+    {"\"", "\\\""}, {"\\", "\\\\"}, {"\n", "\\n"}, {"\x01", "\\x01"}, {"\x7f", "\\x7f"},
+    {"\xc3\xa9", "\xc3\xa9"}, {"\x80", "\\x80"}
+  };
+  for (const auto& special : specials) {
+    for (size_t offset = 0; offset < 70; offset++) {
+      const std::string before(offset, 'a'), after(70 - offset, 'b');
+      REQUIRE(printed(before + special.first + after) == "\"" + before + special.second + after + "\"\n");
+    }
+  }
+}
+
+TEST_CASE("Quoted characters and tuple strings are escaped",
+	  "[escape]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.quotes(true);
+  printer.print('\'');
+  printer.print('\n');
+  printer.quotes(false);
+  printer.print(std::make_tuple(std::string("a\"b"), '\t'));
+  REQUIRE(stream.str() == "'\\''\n'\\n'\n(\"a\\\"b\", '\\t')\n");
+}
+
+TEST_CASE("Cut strings are escaped up to the cut",
+	  "[escape]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.quotes(true).max_string_length(4);
+  printer.print("a\nbcdef");
+  REQUIRE(stream.str() == "\"a\\nbc...\"\n");
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+namespace format_test {
+
+  // Checks pformat(value) against print(value) on a stream, both with the
+  // settings made by configure
+  template <typename T, typename Configure>
+  void check(const T& value, Configure configure) {
+    std::stringstream stream;
+    pprint::PrettyPrinter printer(stream), options;
+    configure(printer);
+    configure(options);
+    printer.print(value);
+    REQUIRE(pprint::pformat(value, options) == stream.str());
+  }
+
+  // A container a back inserter can append to, with push_back only
+  struct Characters {
+    typedef char value_type;
+    std::string text;
+    void push_back(char c) { text.push_back(c); }
+  };
+
+}
+
+TEST_CASE("pformat returns what print writes",
+	  "[format]") {
+  using namespace format_test;
+  std::map<std::string, std::vector<int>> map {{"a", {1, 2}}, {"b", {}}};
+  std::vector<std::vector<double>> nested(50, std::vector<double> {0.5, -1e10});
+  REQUIRE(pprint::pformat(map) == "{\n  a : [1, 2], \n  b : []\n}\n");
+  REQUIRE(pprint::pformat(5) == "5\n");
+  for (bool compact : {false, true}) {
+    for (size_t width : {size_t(0), size_t(20)}) {
+      auto configure = [&](pprint::PrettyPrinter& printer) {
+        printer.compact(compact).quotes(compact).width(width).indent(compact ? 4 : 2).flush_threshold(64);
+      };
+      check(map, configure);
+      check(nested, configure);
+      check(std::string("say \"hi\""), configure);
+    }
+  }
+}
+
+TEST_CASE("format_to writes to output iterators",
+	  "[format]") {
+  pprint::PrettyPrinter options;
+  options.compact(true).quotes(true);
+  std::string text = "value: ";
+  pprint::format_to(std::back_inserter(text), std::vector<std::string> {"x", "y"}, options);
+  REQUIRE(text == "value: [\"x\", \"y\"]\n");
+
+  char buffer[32] = {};
+  char * end = pprint::format_to(buffer, std::set<int> {3, 1, 2}, options);
+  REQUIRE(std::string(buffer, end) == "{1, 2, 3}\n");
+
+  std::list<char> characters;
+  pprint::format_to(std::back_inserter(characters), 12);
+  REQUIRE(std::string(characters.begin(), characters.end()) == "12\n");
+
+  format_test::Characters appended;
+  pprint::format_to(std::back_inserter(appended), std::vector<int>(100, 7), options.flush_threshold(64));
+  REQUIRE(appended.text == pprint::pformat(std::vector<int>(100, 7), options));
+}
+
+TEST_CASE("Formatting to strings leaves their format state alone",
+	  "[format]") {
+  const std::ostream& state = pprint::default_format_state();
+  pprint::pformat(std::vector<double> {1.5, 2.5});
+  std::string text;
+  pprint::format_to(std::back_inserter(text), std::map<int, int> {{1, 2}});
+  REQUIRE(state.flags() == (std::ios_base::skipws | std::ios_base::dec));
+  REQUIRE(state.precision() == 6);
+}
+
+TEST_CASE("Formatting ignores the state of std::cout",
+	  "[format]") {
+  std::cout << std::hex << std::setprecision(2);
+  const std::string hex = pprint::pformat(std::vector<double> {255, 3.14159}, pprint::PrettyPrinter().compact(true));
+  std::cout << std::dec << std::setprecision(6);
+  REQUIRE(hex == "[255, 3.14159]\n");
+}
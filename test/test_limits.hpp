@@ -0,0 +1,90 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("max_items elides the rest of a container",
+	  "[limits]") {
+  std::vector<int> foo;
+  for (int i = 1; i <= 10000; i++)
+    foo.push_back(i);
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true).max_items(3);
+  printer.print(foo);
+  REQUIRE(stream.str() == "[1, 2, 3, ... 9997 more]\n");
+
+  stream.str("");
+  printer.compact(false);
+  printer.print(foo);
+  REQUIRE(stream.str() == "[\n  1, \n  2, \n  3, \n  ... 9997 more\n]\n");
+}
+
+TEST_CASE("max_items applies to every container family",
+	  "[limits]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true).max_items(2);
+  printer.print(std::list<int>{1, 2, 3});
+  printer.print(std::set<int>{1, 2, 3, 4});
+  printer.print(std::map<int, int>{{1, 10}, {2, 20}, {3, 30}});
+  printer.print(std::array<int, 3>{1, 2, 3});
+  printer.print(std::vector<int>{1, 2});
+  REQUIRE(stream.str() ==
+          "[1, 2, ... 1 more]\n"
+          "{1, 2, ... 2 more}\n"
+          "{1 : 10, 2 : 20, ... 1 more}\n"
+          "[1, 2, ... 1 more]\n"
+          "[1, 2]\n");
+}
+
+namespace test_types {
+  struct Visited {
+    static inline int visits = 0;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Visited&) {
+    Visited::visits += 1;
+    return os << "v";
+  }
+}
+
+TEST_CASE("max_items stops visiting elements once the budget is spent",
+	  "[limits]") {
+  std::vector<test_types::Visited> foo(1000);
+  test_types::Visited::visits = 0;
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true).max_items(4);
+  printer.print(foo);
+  REQUIRE(stream.str() == "[v, v, v, v, ... 996 more]\n");
+  REQUIRE(test_types::Visited::visits == 4);
+}
+
+TEST_CASE("max_depth elides nested containers",
+	  "[limits]") {
+  std::vector<std::vector<std::map<int, int>>> foo {{{{1, 2}}}, {}};
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true).max_depth(1);
+  printer.print(foo);
+  printer.max_depth(2);
+  printer.print(foo);
+  printer.max_depth(0);
+  printer.print(foo);
+  REQUIRE(stream.str() == "[[...], [...]]\n[[{...}], []]\n[...]\n");
+}
+
+TEST_CASE("max_string_length cuts long strings",
+	  "[limits]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true).quotes(true).max_string_length(5);
+  printer.print(std::vector<std::string>{"Hello, World", "short"});
+  printer.max_string_length(4);
+  printer.print("\xc3\xa9t\xc3\xa9 \xc3\xa9t\xc3\xa9");
+  REQUIRE(stream.str() == "[\"Hello...\", \"short\"]\n\"\xc3\xa9t...\"\n");
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+#include "allocations.hpp"
+
+namespace measure_test {
+
+  struct Vector2 {
+    double x, y;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Vector2& value) {
+    return os << "Vector2(" << value.x << ", " << value.y << ")";
+  }
+
+  // Checks measure(values...) against what print(values...) writes
+  template <typename... Args>
+  void check(pprint::PrettyPrinter& printer, std::stringstream& stream, const Args&... values) {
+    stream.str("");
+    const pprint::Measurement measurement = printer.measure(values...);
+    printer.print(values...);
+    const std::string output = stream.str();
+    REQUIRE(measurement.bytes == output.size());
+    REQUIRE(measurement.lines == static_cast<size_t>(std::count(output.begin(), output.end(), '\n')));
+  }
+
+}
+
+TEST_CASE("Measurements match the printed output",
+	  "[measure]") {
+  using namespace measure_test;
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  std::map<std::string, std::vector<long long>> map {
+    {"zero", {0}}, {"small", {-9, 10, 99}}, {"big", {std::numeric_limits<long long>::min(), 1234567890123}},
+    {"quoted \"\n", {}}
+  };
+  std::vector<double> doubles {0.1, -2.5e300, 3.0, 1e-7};
+  for (bool compact : {false, true}) {
+    for (size_t width : {size_t(0), size_t(30)}) {
+      printer.compact(compact).width(width).quotes(compact);
+      check(printer, stream, map);
+      check(printer, stream, doubles, 'c', "text");
+      check(printer, stream, std::vector<Vector2> {{1.5, 2}, {-3, 4}});
+      check(printer, stream, std::make_tuple(1u, std::string("two"), 3.0f), std::set<int> {});
+      check(printer, stream, std::numeric_limits<unsigned long long>::max(), -1, 0);
+    }
+  }
+  printer.width(0).max_items(2).max_string_length(3);
+  check(printer, stream, map, std::string(10, 'x'));
+}
+
+TEST_CASE("Measuring writes nothing and honours the stream's formatting",
+	  "[measure]") {
+  std::stringstream stream;
+  stream << std::hex;
+  pprint::PrettyPrinter printer(stream);
+  REQUIRE(printer.measure(255).bytes == 3);
+  REQUIRE(printer.measure(std::vector<int> {1, 2}).lines == 4);
+  REQUIRE(printer.measure({1, 2, 3}).bytes == printer.measure(std::vector<int> {1, 2, 3}).bytes);
+  REQUIRE(stream.str().empty());
+}
+
+TEST_CASE("Measuring stops allocating once warmed up",
+	  "[measure]") {
+  using namespace measure_test;
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  std::map<std::string, int> map;
+  for (int i = 0; i < 100; i++)
+    map["key" + std::to_string(i)] = i;
+  const std::vector<Vector2> vectors(50, Vector2 {1.5, 2});
+  for (size_t width : {0, 80}) {
+    printer.width(width);
+    for (int warm_up = 0; warm_up < 2; warm_up++)
+      printer.measure(map, vectors);
+    REQUIRE(allocations_of([&] { printer.measure(map); }) == 0);
+    REQUIRE(allocations_of([&] { printer.measure(vectors); }) == 0);
+  }
+}
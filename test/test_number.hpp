@@ -0,0 +1,59 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("Doubles are printed with the shortest round-trip representation",
+	  "[number]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(0.1 + 0.2, 0.5, 1e21, 100.0);
+  REQUIRE(stream.str() == "0.30000000000000004 0.5 1e+21 100\n");
+}
+
+TEST_CASE("Floats keep their suffix",
+	  "[number]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(std::vector<float>{3.14f, 0.1f});
+  REQUIRE(stream.str() == "[3.14f, 0.1f]\n");
+}
+
+TEST_CASE("Float format and precision can be chosen on the printer",
+	  "[number]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.float_format(pprint::FloatFormat::fixed).precision(2);
+  printer.print(3.14159);
+  printer.float_format(pprint::FloatFormat::scientific).precision(3);
+  printer.print(1234.5);
+  printer.float_format(pprint::FloatFormat::general).precision(-1);
+  printer.print(0.1 + 0.2);
+  REQUIRE(stream.str() == "3.14\n1.234e+03\n0.3\n");
+}
+
+TEST_CASE("Integers and complex numbers",
+	  "[number]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(-42, 18446744073709551615ull, std::complex<double>(1.5, -0.25));
+  REQUIRE(stream.str() == "-42 18446744073709551615 (1.5 + -0.25i)\n");
+}
+
+TEST_CASE("Tuples print numbers the same way",
+	  "[number]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(std::make_tuple(0.1 + 0.2, 2.5f, 'a', "b", std::vector<int>{1, 2}));
+  REQUIRE(stream.str() == "(0.30000000000000004, 2.5, 'a', \"b\", [1, 2])\n");
+}
+
+TEST_CASE("Integers honour std::hex on the stream",
+	  "[number]") {
+  std::stringstream stream;
+  stream << std::hex;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(255);
+  REQUIRE(stream.str() == "ff\n");
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("Output reaches the stream at the end of every print",
+	  "[output]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(std::vector<int>{1, 2, 3});
+  REQUIRE(stream.str() == "[\n  1, \n  2, \n  3\n]\n");
+
+  stream << "-";
+  printer.print("foo", 5);
+  REQUIRE(stream.str() == "[\n  1, \n  2, \n  3\n]\n-foo 5\n");
+}
+
+TEST_CASE("Flushing mid-print does not change the output",
+	  "[output]") {
+  std::map<std::string, std::vector<int>> foo {{"a", {1, 2, 3}}, {"b", {4, 5}}, {"c", {}}};
+
+  std::stringstream expected;
+  pprint::PrettyPrinter reference(expected);
+  reference.quotes(true);
+  reference.print(foo);
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.quotes(true);
+  printer.flush_threshold(1);
+  printer.print(foo);
+
+  REQUIRE(stream.str() == expected.str());
+}
+
+TEST_CASE("Numbers honour the formatting state of the stream",
+	  "[output]") {
+  std::stringstream stream;
+  stream << std::fixed << std::setprecision(2);
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(std::vector<double>{3.14159, 2.0});
+
+  REQUIRE(stream.str() == "[3.14, 2.00]\n");
+}
+
+namespace test_types {
+  struct Widget {};
+}
+
+TEST_CASE("Objects without operator<< are printed by type name",
+	  "[output]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(std::vector<test_types::Widget>(2));
+
+  REQUIRE(stream.str() == "[<Object test_types::Widget>, <Object test_types::Widget>]\n");
+}
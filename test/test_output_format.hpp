@@ -0,0 +1,112 @@
+#pragma once
+#include <pprint.hpp>
+
+#include "catch2/catch.hpp"
+
+namespace output_format_test {
+
+  enum class Level { info, warning };
+
+  struct Opaque {};
+
+  struct Point {
+    int x, y;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Point& value) {
+    return os << "Point(\"" << value.x << "\", " << value.y << ")";
+  }
+
+}
+
+TEST_CASE("JSON output encodes every kind of value",
+	  "[output_format]") {
+  using namespace output_format_test;
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  // Text settings do not change machine-readable output
+  printer.output_format(pprint::OutputFormat::json).width(10).max_items(1).max_string_length(1).quotes(true);
+  printer.print(std::map<std::string, std::vector<int>> {{"a", {1, 2}}, {"b", {}}});
+  printer.print(std::map<int, Level> {{1, Level::warning}, {2, static_cast<Level>(5)}});
+  printer.print(std::set<char> {'b', 'a'}, std::make_tuple(1, 2.5f, "three"), std::make_pair(true, 'x'));
+  printer.print(std::optional<int> {}, nullptr, std::variant<int, std::string> {"v"}, std::complex<double>(1, -2));
+  printer.print(std::nan(""), std::numeric_limits<double>::infinity(), Opaque {}, Point {1, 2});
+  printer.print(std::map<std::pair<int, int>, int> {{{1, 2}, 3}});
+  REQUIRE(stream.str() ==
+    "{\"a\":[1,2],\"b\":[]}\n"
+    "{\"1\":\"warning\",\"2\":5}\n"
+    "[[\"a\",\"b\"],[1,2.5,\"three\"],[true,\"x\"]]\n"
+    "[null,null,\"v\",{\"real\":1,\"imag\":-2}]\n"
+    "[null,null,\"<Object output_format_test::Opaque>\",\"Point(\\\"1\\\", 2)\"]\n"
+    "{\"[1,2]\":3}\n");
+}
+
+TEST_CASE("Smart pointers are what they point to in JSON and logfmt",
+	  "[output_format]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  const auto shared = std::make_shared<std::string>("shared value");
+  const std::weak_ptr<std::string> weak = shared;
+  printer.output_format(pprint::OutputFormat::json);
+  printer.print(std::unique_ptr<int>(), std::make_unique<int>(7), shared, weak, std::weak_ptr<int>());
+  printer.print(std::make_unique<std::vector<int>>(std::vector<int> {1, 2}));
+  printer.output_format(pprint::OutputFormat::logfmt);
+  printer.print(std::shared_ptr<int>(), std::make_unique<int>(7), shared);
+  REQUIRE(stream.str() ==
+    "[null,7,\"shared value\",\"shared value\",null]\n"
+    "[1,2]\n"
+    "arg0=null arg1=7 arg2=\"shared value\"\n");
+}
+
+TEST_CASE("JSON strings are escaped as JSON",
+	  "[output_format]") {
+  std::stringstream stream;
+  stream << std::hex;
+  pprint::PrettyPrinter printer(stream);
+  printer.output_format(pprint::OutputFormat::json);
+  printer.print(std::string("q\"\\\n\t\x01\x7f caf\xc3\xa9 \xff \xe2\x80\xa8"), 255);
+  REQUIRE(stream.str() == "[\"q\\\"\\\\\\n\\t\\u0001\\u007f caf\xc3\xa9 \\ufffd \\u2028\",255]\n");
+}
+
+TEST_CASE("logfmt output has a field per map entry and argument",
+	  "[output_format]") {
+  using namespace output_format_test;
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.output_format(pprint::OutputFormat::logfmt);
+  printer.print(std::map<std::string, std::map<std::string, int>> {{"http", {{"code", 200}, {"ms", 12}}}});
+  printer.print(std::make_pair(std::string("user name"), std::string("a \"b\"")), Level::info, "", 1.5);
+  printer.print(std::vector<std::string> {"x"}, std::map<std::string, int> {}, std::map<int, int> {{1, 2}});
+  REQUIRE(stream.str() ==
+    "http.code=200 http.ms=12\n"
+    "\"user name\"=\"a \\\"b\\\"\" arg1=info arg2=\"\" arg3=1.5\n"
+    "arg0=\"[\\\"x\\\"]\" 1=2\n");
+}
+
+TEST_CASE("logfmt keys are quoted rather than rewritten, so they stay distinct",
+	  "[output_format]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.output_format(pprint::OutputFormat::logfmt);
+  printer.print(std::map<std::string, int> {{"a b", 1}, {"a_b", 2}, {"c=d", 3}, {"", 4}, {"_", 5}});
+  REQUIRE(stream.str() == "\"\"=4 _=5 \"a b\"=1 a_b=2 \"c=d\"=3\n");
+}
+
+TEST_CASE("Machine-readable output is the same deferred, measured and in parallel",
+	  "[output_format]") {
+  std::map<std::string, std::vector<int>> map;
+  for (int i = 0; i < 3000; i++)
+    map["key " + std::to_string(i)] = {i, -i};
+  for (auto format : {pprint::OutputFormat::json, pprint::OutputFormat::logfmt, pprint::OutputFormat::binary}) {
+    std::stringstream sequential, parallel, deferred;
+    pprint::PrettyPrinter(sequential).output_format(format).print(map, std::string("end"));
+    pprint::PrettyPrinter printer(parallel);
+    printer.output_format(format).parallel(true).parallel_threshold(2).print(map, std::string("end"));
+    REQUIRE(parallel.str() == sequential.str());
+    REQUIRE(printer.measure(map, std::string("end")).bytes == sequential.str().size());
+    pprint::PrettyPrinter later(deferred);
+    later.output_format(format).deferred(true).print(map, std::string("end"));
+    later.flush();
+    REQUIRE(deferred.str() == sequential.str());
+  }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <pprint.hpp>
+#include <stdexcept>
+
+#include "catch2/catch.hpp"
+
+namespace parallel_test {
+
+  // Output of print(value) with a sequential and with a parallel printer
+  template <typename T>
+  std::pair<std::string, std::string> both(const T& value, bool compact, size_t max_items) {
+    std::stringstream sequential, parallel;
+    pprint::PrettyPrinter(sequential).compact(compact).max_items(max_items).quotes(true).print(value);
+    pprint::PrettyPrinter(parallel).compact(compact).max_items(max_items).quotes(true)
+      .parallel(true).parallel_threshold(2).print(value);
+    return {sequential.str(), parallel.str()};
+  }
+
+  struct Throws {
+    int value;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Throws& element) {
+    if (element.value == 3000)
+      throw std::runtime_error("element");
+    return os << element.value;
+  }
+
+}
+
+TEST_CASE("Parallel printing matches sequential printing",
+	  "[parallel]") {
+  using namespace parallel_test;
+  std::vector<double> doubles;
+  std::vector<std::vector<int>> nested;
+  std::map<std::string, std::vector<int>> map;
+  std::set<int> set;
+  std::deque<std::string> strings;
+  for (int i = 0; i < 5000; i++) {
+    doubles.push_back(i * 0.1);
+    if (i % 10 == 0)
+      nested.push_back({i, i + 1});
+    map["key" + std::to_string(i)] = {i};
+    set.insert(i * 3);
+    strings.push_back(std::to_string(i));
+  }
+  std::stack<int> stack;
+  for (int i = 0; i < 3000; i++)
+    stack.push(i);
+
+  for (bool compact : {true, false}) {
+    for (size_t max_items : {std::numeric_limits<size_t>::max(), size_t(2500), size_t(1)}) {
+      auto outputs = both(doubles, compact, max_items);
+      REQUIRE(outputs.first == outputs.second);
+      outputs = both(nested, compact, max_items);
+      REQUIRE(outputs.first == outputs.second);
+      outputs = both(map, compact, max_items);
+      REQUIRE(outputs.first == outputs.second);
+      outputs = both(set, compact, max_items);
+      REQUIRE(outputs.first == outputs.second);
+      outputs = both(strings, compact, max_items);
+      REQUIRE(outputs.first == outputs.second);
+      outputs = both(stack, compact, max_items);
+      REQUIRE(outputs.first == outputs.second);
+      outputs = both(std::vector<int> {1, 2}, compact, max_items);
+      REQUIRE(outputs.first == outputs.second);
+    }
+  }
+}
+
+TEST_CASE("Parallel printing rethrows exceptions of elements",
+	  "[parallel]") {
+  using namespace parallel_test;
+  std::vector<Throws> values;
+  for (int i = 0; i < 5000; i++)
+    values.push_back({i});
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.parallel(true).parallel_threshold(2);
+  REQUIRE_THROWS_AS(printer.print(values), std::runtime_error);
+}
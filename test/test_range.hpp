@@ -0,0 +1,154 @@
+#pragma once
+#include <pprint.hpp>
+#include <forward_list>
+
+#include "catch2/catch.hpp"
+
+namespace test_types {
+  // Single-pass, endless input iterator: 0, 1, 2, ...
+  struct Naturals {
+    typedef std::input_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef const int& reference;
+
+    int value = 0;
+
+    const int& operator*() const { return value; }
+    Naturals& operator++() { value += 1; return *this; }
+  };
+
+  struct Unreachable {};
+
+  inline bool operator==(const Naturals&, Unreachable) { return false; }
+  inline bool operator!=(const Naturals&, Unreachable) { return true; }
+
+  struct Path : std::vector<std::string> {
+    using std::vector<std::string>::vector;
+  };
+
+  struct Name : std::vector<std::string> {
+    using std::vector<std::string>::vector;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Name& name) {
+    for (const auto& part : name)
+      os << (&part == &name.front() ? "" : ".") << part;
+    return os;
+  }
+
+  // Shaped like std::complex, with an operator<< of its own
+  struct Polar {
+    typedef double value_type;
+    double radius, angle;
+    double real() const { return radius * std::cos(angle); }
+    double imag() const { return radius * std::sin(angle); }
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, const Polar& value) {
+    return os << value.radius << "@" << value.angle;
+  }
+
+  // Shaped like std::stack, without a value_type or an operator<<
+  struct Tower {
+    typedef std::vector<int> container_type;
+    int top() const { return 1; }
+  };
+
+  // A key_type and a mapped_type, but elements that are not pairs
+  struct Keys : std::vector<int> {
+    typedef int key_type;
+    typedef int mapped_type;
+    using std::vector<int>::vector;
+  };
+}
+
+TEST_CASE("Print an input range as it is read",
+	  "[range]") {
+  std::istringstream input("1 2 3");
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print(pprint::range(std::istream_iterator<int>(input), std::istream_iterator<int>()));
+  REQUIRE(stream.str() == "[\n  1, \n  2, \n  3\n]\n");
+}
+
+TEST_CASE("Input ranges have the same layout as vectors",
+	  "[range]") {
+  for (bool compact : {false, true}) {
+    for (std::string text : {"", "1", "1 2"}) {
+      std::istringstream input(text);
+      std::vector<int> foo;
+      for (int value; input >> value; )
+        foo.push_back(value);
+
+      std::stringstream expected;
+      pprint::PrettyPrinter reference(expected);
+      reference.compact(compact);
+      reference.print(foo);
+
+      std::istringstream again(text);
+      std::stringstream stream;
+      pprint::PrettyPrinter printer(stream);
+      printer.compact(compact);
+      printer.print(pprint::range(std::istream_iterator<int>(again), std::istream_iterator<int>()));
+      REQUIRE(stream.str() == expected.str());
+    }
+  }
+}
+
+TEST_CASE("Print an endless range with max_items",
+	  "[range]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true).max_items(3);
+  printer.print(pprint::range(test_types::Naturals(), test_types::Unreachable()));
+  printer.compact(false);
+  printer.print(pprint::range(test_types::Naturals(), test_types::Unreachable()));
+  REQUIRE(stream.str() == "[0, 1, 2, ...]\n[\n  0, \n  1, \n  2, \n  ...\n]\n");
+}
+
+TEST_CASE("Ranges without operator<< are printed like vectors",
+	  "[range]") {
+  std::vector<int> foo {1, 2, 3, 4};
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(std::forward_list<int>{1, 2, 3});
+  printer.print(pprint::range(foo.begin() + 1, foo.end()));
+  printer.print(pprint::range(foo));
+  REQUIRE(stream.str() == "[1, 2, 3]\n[2, 3, 4]\n[1, 2, 3, 4]\n");
+}
+
+TEST_CASE("Classes are printed with operator<< first, then as ranges",
+	  "[range]") {
+  using namespace test_types;
+  static_assert(std::is_same_v<pprint::category_of<std::vector<int>>::type, pprint::category::sequence>);
+  static_assert(std::is_same_v<pprint::category_of<std::stack<int>>::type, pprint::category::stack>);
+  static_assert(std::is_same_v<pprint::category_of<std::forward_list<int>>::type, pprint::category::range>);
+  static_assert(std::is_same_v<pprint::category_of<Naturals>::type, pprint::category::object>);
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(Path {"usr", "lib"});
+  printer.print(Name {"std", "vector"});
+  REQUIRE(stream.str() == "[usr, lib]\nstd.vector\n");
+}
+
+TEST_CASE("Classes shaped like standard types keep being printed as themselves",
+	  "[range]") {
+  using namespace test_types;
+  static_assert(std::is_same_v<pprint::category_of<Polar>::type, pprint::category::streamable>);
+  static_assert(std::is_same_v<pprint::category_of<Tower>::type, pprint::category::object>);
+  static_assert(std::is_same_v<pprint::category_of<Keys>::type, pprint::category::set>);
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.compact(true);
+  printer.print(Polar {2, 0.5});
+  printer.print(Tower {});
+  printer.print(Keys {1, 2});
+  REQUIRE(stream.str() == "2@0.5\n<Object test_types::Tower>\n{1, 2}\n");
+}
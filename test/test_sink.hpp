@@ -0,0 +1,162 @@
+#pragma once
+#include <pprint.hpp>
+#include <future>
+#include <thread>
+#include <chrono>
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#endif
+
+#include "catch2/catch.hpp"
+
+namespace test_types {
+  // Holds back every write until opened, to fill up a sink's queue
+  class GatedBuffer : public std::stringbuf {
+  public:
+    void open() { gate_.set_value(); }
+
+  protected:
+    std::streamsize xsputn(const char * s, std::streamsize n) override {
+      opened_.wait();
+      return std::stringbuf::xsputn(s, n);
+    }
+
+  private:
+    std::promise<void> gate_;
+    std::shared_future<void> opened_ = gate_.get_future().share();
+  };
+
+  inline std::vector<std::string> lines(const std::string& text) {
+    std::vector<std::string> result;
+    std::istringstream stream(text);
+    for (std::string line; std::getline(stream, line); )
+      result.push_back(line);
+    return result;
+  }
+}
+
+TEST_CASE("Records reach the stream after AsyncSink::flush",
+	  "[sink]") {
+  std::stringstream stream;
+  pprint::AsyncSink sink(stream, 16);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&sink, t] {
+      pprint::PrettyPrinter printer(sink);
+      printer.compact(true);
+      for (int i = 0; i < 100; i++)
+        printer.print("thread", t, std::vector<int>{i, i});
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  sink.flush();
+
+  const auto records = test_types::lines(stream.str());
+  REQUIRE(records.size() == 400);
+  for (const auto& record : records)
+    REQUIRE(record.substr(0, 7) == "thread ");
+  REQUIRE(sink.dropped() == 0);
+  REQUIRE(sink.high_water_mark() <= sink.capacity());
+}
+
+TEST_CASE("AsyncSink's high water mark stays within its capacity under contention",
+	  "[sink]") {
+  std::stringstream stream;
+  pprint::AsyncSink sink(stream, 4096);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 16; t++) {
+    threads.emplace_back([&sink] {
+      pprint::PrettyPrinter printer(sink);
+      for (int i = 0; i < 2000; i++)
+        printer.print(i);
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  sink.flush();
+
+  REQUIRE(test_types::lines(stream.str()).size() + sink.dropped() == 16 * 2000);
+  REQUIRE(sink.high_water_mark() > 0);
+  REQUIRE(sink.high_water_mark() <= sink.capacity());
+}
+
+TEST_CASE("A full AsyncSink blocks without spinning until there is room",
+	  "[sink]") {
+  test_types::GatedBuffer buffer;
+  std::ostream stream(&buffer);
+  pprint::AsyncSink sink(stream, 4, pprint::OverflowPolicy::block);
+  std::chrono::nanoseconds busy {0};
+  std::thread producer([&] {
+    pprint::PrettyPrinter printer(sink);
+    for (int i = 0; i < 100; i++)
+      printer.print(i);
+#if defined(__unix__) || defined(__APPLE__)
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    busy = std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  buffer.open();
+  producer.join();
+  sink.flush();
+
+  const auto records = test_types::lines(buffer.str());
+  REQUIRE(sink.dropped() == 0);
+  REQUIRE(records.size() == 100);
+  REQUIRE(records.front() == "0");
+  REQUIRE(records.back() == "99");
+  // Spinning would have kept the producer busy for most of the 200ms
+  REQUIRE(busy < std::chrono::milliseconds(100));
+}
+
+TEST_CASE("A full AsyncSink drops the newest records",
+	  "[sink]") {
+  test_types::GatedBuffer buffer;
+  std::ostream stream(&buffer);
+  pprint::AsyncSink sink(stream, 4, pprint::OverflowPolicy::drop_newest);
+  pprint::PrettyPrinter printer(sink);
+  for (int i = 0; i < 100; i++)
+    printer.print(i);
+  buffer.open();
+  sink.flush();
+
+  const auto records = test_types::lines(buffer.str());
+  REQUIRE(sink.dropped() > 0);
+  REQUIRE(records.size() + sink.dropped() == 100);
+  REQUIRE(records.front() == "0");
+  REQUIRE(sink.high_water_mark() == 4);
+}
+
+TEST_CASE("A full AsyncSink drops the oldest records",
+	  "[sink]") {
+  test_types::GatedBuffer buffer;
+  std::ostream stream(&buffer);
+  pprint::AsyncSink sink(stream, 4, pprint::OverflowPolicy::drop_oldest);
+  pprint::PrettyPrinter printer(sink);
+  for (int i = 0; i < 100; i++)
+    printer.print(i);
+  buffer.open();
+  sink.flush();
+
+  const auto records = test_types::lines(buffer.str());
+  REQUIRE(sink.dropped() > 0);
+  REQUIRE(records.size() + sink.dropped() == 100);
+  REQUIRE(records.back() == "99");
+}
+
+TEST_CASE("AsyncSink::shutdown writes what is queued",
+	  "[sink]") {
+  std::stringstream stream;
+  pprint::AsyncSink sink(stream);
+  pprint::PrettyPrinter printer(sink);
+  printer.print("before");
+  sink.shutdown();
+  REQUIRE(stream.str() == "before\n");
+
+  printer.print("after");
+  sink.flush();
+  REQUIRE(stream.str() == "before\n");
+  REQUIRE(sink.dropped() == 1);
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <pprint.hpp>
+#include <thread>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("Thread-safe printers emit whole records",
+	  "[thread]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter shared(stream);
+  shared.thread_safe(true);
+
+  const size_t threads = 4, records = 200;
+  std::vector<std::string> expected;
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; t++) {
+    std::vector<std::string> value(3, std::string(50, static_cast<char>('a' + t)));
+    std::stringstream record;
+    pprint::PrettyPrinter(record).print("thread", t, value);
+    expected.push_back(record.str());
+
+    workers.emplace_back([&shared, &stream, value, t] {
+      // Odd threads use a printer of their own on the same stream
+      pprint::PrettyPrinter own(stream);
+      own.thread_safe(true);
+      pprint::PrettyPrinter& printer = t % 2 ? own : shared;
+      for (size_t i = 0; i < records; i++)
+        printer.print("thread", t, value);
+    });
+  }
+  for (auto& worker : workers)
+    worker.join();
+
+  const std::string output = stream.str();
+  std::vector<size_t> seen(threads, 0);
+  size_t position = 0;
+  while (position < output.size()) {
+    size_t match = threads;
+    for (size_t t = 0; t < threads; t++) {
+      if (output.compare(position, expected[t].size(), expected[t]) == 0)
+        match = t;
+    }
+    REQUIRE(match < threads);
+    seen[match] += 1;
+    position += expected[match].size();
+  }
+  REQUIRE(seen == std::vector<size_t>(threads, records));
+}
+
+TEST_CASE("Thread-safe printing keeps the output of a plain print",
+	  "[thread]") {
+  std::map<std::string, std::vector<int>> foo {{"a", {1, 2}}, {"b", {}}};
+
+  std::stringstream expected;
+  pprint::PrettyPrinter reference(expected);
+  reference.print(foo);
+  reference.print_inline("foo", 1.5, std::stack<int>({1, 2}));
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.thread_safe(true).flush_threshold(1);
+  printer.print(foo);
+  printer.print_inline("foo", 1.5, std::stack<int>({1, 2}));
+  REQUIRE(stream.str() == expected.str());
+}
@@ -135,3 +135,23 @@ TEST_CASE("Print another nested matrix (line_terminator = '/n', indent = 2)",
 
   REQUIRE(stream.str() == expected);
 }
+
+TEST_CASE("Print initializer_list in the order it was written (line_terminator = '/n', indent = 2)",
+	  "[std::initializer_list]") {
+
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.print({3, 1, 2, 1});
+  printer.compact(true);
+  printer.print({3, 1, 2, 1});
+
+  const std::string expected = "[\n"
+    "  3, \n"
+    "  1, \n"
+    "  2, \n"
+    "  1"
+    "\n]\n"
+    "[3, 1, 2, 1]\n";
+
+  REQUIRE(stream.str() == expected);
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <pprint.hpp>
+#include "allocations.hpp"
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("Containers that fit in the width stay on one line",
+	  "[width]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.width(80);
+  printer.print(std::vector<std::vector<int>> {{1, 2}, {3}});
+  printer.print(std::map<int, std::set<int>> {{1, {2, 3}}});
+  printer.print(std::vector<int> {});
+  REQUIRE(stream.str() == "[[1, 2], [3]]\n{1 : {2, 3}}\n[]\n");
+}
+
+TEST_CASE("Containers too wide for the line are broken one level at a time",
+	  "[width]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.quotes(true).width(24);
+  printer.print(std::map<std::string, std::vector<int>> {{"a", {1, 2, 3}}, {"b", std::vector<int>(8, 7)}});
+  REQUIRE(stream.str() ==
+    "{\n"
+    "  \"a\" : [1, 2, 3], \n"
+    "  \"b\" : [\n"
+    "    7, \n    7, \n    7, \n    7, \n    7, \n    7, \n    7, \n    7\n"
+    "  ]\n"
+    "}\n");
+}
+
+TEST_CASE("Broken lines end as the lines printed without a width do",
+	  "[width]") {
+  // Too wide for the line, with elements that fit: broken at the top only,
+  // as printing without a width does
+  std::stringstream expanded, broken;
+  pprint::PrettyPrinter printer(expanded), narrow(broken);
+  printer.quotes(true);
+  narrow.quotes(true).width(20);
+  for (pprint::PrettyPrinter * to : {&printer, &narrow}) {
+    to->print(std::map<std::string, std::vector<int>> {{"a", {1, 2}}, {"b", {}}});
+    to->print(std::vector<std::vector<int>> {{1, 2}, {3}, {4, 5, 6}});
+    to->print(std::set<int> {1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    to->print("label", std::vector<int> {1, 2, 3, 4, 5, 6});
+  }
+  REQUIRE(broken.str() == expanded.str());
+}
+
+TEST_CASE("Width-aware layout stops allocating once warmed up",
+	  "[width]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.width(80);
+  const std::vector<int> numbers(1000, 7);
+  const std::map<std::string, std::vector<double>> map {{"a", {1.5, 2.5}}, {"b", std::vector<double>(100, 0.5)}};
+  for (int warm_up = 0; warm_up < 2; warm_up++) {
+    printer.print(numbers, map);
+    stream.str("");
+  }
+  REQUIRE(allocations_of([&] { printer.print(numbers, map); }) == 0);
+}
+
+TEST_CASE("Width counts the text before a container and after it",
+	  "[width]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.width(16);
+  // "[1, 2, 3]" fits in 16 columns, but not after the label
+  printer.print("a long label", std::vector<int> {1, 2, 3});
+  REQUIRE(stream.str() == "a long label [\n  1, \n  2, \n  3\n]\n");
+}
+
+TEST_CASE("Width-aware layout honours max_items and print_inline indentation",
+	  "[width]") {
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.width(10).max_items(2).indent(4);
+  printer.print_inline(std::vector<int>(100, 12345));
+  REQUIRE(stream.str() == "    [\n        12345, \n        12345, \n        ... 98 more\n    ]\n");
+}
+
+TEST_CASE("Width-aware layout is linear in deeply nested data",
+	  "[width]") {
+  // Every level is too wide, so each one is broken; the output (and the
+  // work) grows with the number of elements only
+  std::vector<std::vector<std::vector<int>>> value(50, std::vector<std::vector<int>>(50, std::vector<int>(30, 1)));
+  std::stringstream stream;
+  pprint::PrettyPrinter printer(stream);
+  printer.width(40);
+  printer.print(value);
+  const std::string output = stream.str();
+  REQUIRE(std::count(output.begin(), output.end(), '\n') == 1 + 50 * (2 + 50 * 32) + 1);
+}